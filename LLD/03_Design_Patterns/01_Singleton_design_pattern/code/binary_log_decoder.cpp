@@ -0,0 +1,189 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
+#include <cstdint>
+#include "binary_log_format.h"
+using namespace std;
+
+/* ==========================================================
+   BINARY LOG DECODER
+   ----------------------------------------------------------
+   Offline tool for files written by binary_logger.cpp.
+   Reads the format-string dictionary and the per-thread
+   chunks, fills in the "{}" placeholders, and prints every
+   line sorted by time.
+
+   Usage: ./binary_log_decoder [app.blog]
+   ========================================================== */
+
+struct Format {
+    vector<ArgType> types;
+    string text;
+};
+
+struct Line {
+    uint64_t timestamp;
+    uint32_t thread;
+    string text;
+};
+
+class Reader {
+private:
+    const vector<char>& buf;
+    size_t pos;
+    size_t end;
+
+public:
+    Reader(const vector<char>& b, size_t start, size_t stop) : buf(b), pos(start), end(stop) {}
+
+    bool done() const { return pos >= end; }
+    size_t position() const { return pos; }
+
+    uint8_t byte() {
+        if (pos >= end) throw runtime_error("truncated log");
+        return (uint8_t)buf[pos++];
+    }
+
+    uint64_t varint() {
+        uint64_t v = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t b = byte();
+            v |= uint64_t(b & 0x7f) << shift;
+            if (!(b & 0x80)) return v;
+        }
+        throw runtime_error("bad varint");
+    }
+
+    string bytes(size_t n) {
+        if (pos + n > end) throw runtime_error("truncated log");
+        string s(buf.data() + pos, n);
+        pos += n;
+        return s;
+    }
+
+    double float64() {
+        string raw = bytes(sizeof(double));
+        double d;
+        memcpy(&d, raw.data(), sizeof d);
+        return d;
+    }
+};
+
+// Replaces each "{}" in order with the next argument.
+string render(const Format& fmt, const vector<string>& args) {
+    string out;
+    size_t next = 0;
+    for (size_t i = 0; i < fmt.text.size(); i++) {
+        if (fmt.text[i] == '{' && i + 1 < fmt.text.size() && fmt.text[i + 1] == '}' && next < args.size()) {
+            out += args[next++];
+            i++;
+        } else {
+            out += fmt.text[i];
+        }
+    }
+    return out;
+}
+
+int main(int argc, char** argv) {
+    string path = argc > 1 ? argv[1] : "app.blog";
+    ifstream in(path, ios::binary);
+    if (!in) {
+        cerr << "Cannot open " << path << "\n";
+        return 1;
+    }
+    vector<char> buf((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    if (buf.size() < 5 || memcmp(buf.data(), "BLOG2", 5) != 0) {
+        cerr << path << " is not a binary log\n";
+        return 1;
+    }
+
+    unordered_map<uint32_t, Format> formats;
+    unordered_map<uint32_t, uint64_t> lastTime;  // per thread: deltas continue across chunks
+    vector<Line> lines;
+    long records = 0;
+
+    try {
+        Reader file(buf, 5, buf.size());
+        while (!file.done()) {
+            char tag = (char)file.byte();
+            if (tag == 'D') {
+                uint32_t id = (uint32_t)file.varint();
+                Format f;
+                uint8_t n = file.byte();
+                for (int i = 0; i < n; i++) f.types.push_back((ArgType)file.byte());
+                f.text = file.bytes(file.varint());
+                formats[id] = move(f);
+            } else if (tag == 'C') {
+                uint32_t thread = (uint32_t)file.varint();
+                size_t len = file.varint();
+                size_t start = file.position();
+                file.bytes(len);  // skip over the chunk; decoded below
+
+                Reader chunk(buf, start, start + len);
+                uint64_t& ts = lastTime[thread];
+                while (!chunk.done()) {
+                    uint32_t id = (uint32_t)chunk.varint();
+                    ts += chunk.varint();
+                    auto it = formats.find(id);
+                    if (it == formats.end()) throw runtime_error("unknown format id " + to_string(id));
+
+                    vector<string> args;
+                    for (ArgType t : it->second.types) {
+                        if (t == Int) {
+                            args.push_back(to_string(unzigzag(chunk.varint())));
+                        } else if (t == UInt) {
+                            args.push_back(to_string(chunk.varint()));
+                        } else if (t == Double) {
+                            // Shortest text that reads back as the same double
+                            char tmp[32];
+                            auto res = to_chars(tmp, tmp + sizeof tmp, chunk.float64());
+                            args.push_back(string(tmp, res.ptr));
+                        } else if (t == String) {
+                            args.push_back(chunk.bytes(chunk.varint()));
+                        } else {
+                            throw runtime_error("unknown argument type " + to_string(int(t)));
+                        }
+                    }
+                    lines.push_back({ts, thread, render(it->second, args)});
+                    records++;
+                }
+            } else {
+                throw runtime_error("unknown block tag");
+            }
+        }
+    } catch (const exception& e) {
+        cerr << "Stopped decoding: " << e.what() << "\n";
+    }
+
+    stable_sort(lines.begin(), lines.end(),
+                [](const Line& a, const Line& b) { return a.timestamp < b.timestamp; });
+
+    uint64_t first = lines.empty() ? 0 : lines.front().timestamp;
+    for (const Line& l : lines) {
+        printf("[+%12.3f us] [T%u] %s\n", (l.timestamp - first) / 1000.0, l.thread, l.text.c_str());
+    }
+    fprintf(stderr, "%ld records, %zu formats, %zu bytes (%.1f bytes/record)\n",
+            records, formats.size(), buf.size(), records ? double(buf.size()) / records : 0.0);
+    return 0;
+}
+
+/* ==========================================================
+   SAMPLE OUTPUT (first lines of the app.blog written by binary_logger)
+   ----------------------------------------------------------
+   [+       0.000 us] [T0] Application started
+   [+       2.742 us] [T0] User 42 logged in from 10.0.0.7
+   [+       4.301 us] [T0] Order 900001 filled: qty=100 price=101.25
+   [+       5.248 us] [T0] Account 18446744073709551000 balance=1234567.25 limit=-1
+   [+ 1620174.898 us] [T0] Order 900001 filled: qty=100 price=101.25 venue=NYSE
+   [+ 1620175.128 us] [T0] Order 900002 filled: qty=101 price=102.25 venue=NYSE
+   ...
+   1000004 records, 5 formats, 20854335 bytes (20.9 bytes/record)
+   ========================================================== */
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+/* ==========================================================
+   BINARY LOG FORMAT - shared by binary_logger.cpp (writer)
+   and binary_log_decoder.cpp (reader), so the two cannot
+   drift apart. The file layout is described in
+   binary_logger.cpp.
+   ========================================================== */
+
+// Type tag stored once per argument in each 'D' (dictionary) block.
+enum ArgType : uint8_t {
+    Int = 1,     // signed integer  -> zigzag varint
+    Double = 2,  // 8 raw bytes
+    String = 3,  // varint length, bytes
+    UInt = 4     // unsigned integer -> plain varint (all 64 bits)
+};
+
+// Signed values as varints: small magnitudes stay small either sign.
+inline uint64_t zigzag(int64_t v) { return (uint64_t(v) << 1) ^ uint64_t(v >> 63); }
+inline int64_t unzigzag(uint64_t v) { return int64_t(v >> 1) ^ -int64_t(v & 1); }
@@ -0,0 +1,409 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <initializer_list>
+#include <algorithm>
+#include <type_traits>
+#include <cstring>
+#include <cstdio>
+#include <cstdint>
+#include "binary_log_format.h"
+using namespace std;
+
+/* ==========================================================
+   BINARY LOGGER SINGLETON (deferred formatting)
+   ----------------------------------------------------------
+   Even with an async backend (async_logger.cpp), the caller
+   still pays for turning numbers into text. This logger never
+   formats on the calling thread:
+
+   - Each BIN_LOG(...) call site registers its format string
+     ONCE and gets a small integer ID.
+   - A call only appends  [id][time delta][raw args]  to a
+     per-thread buffer (varints, no locks, no allocation).
+   - Full buffers are handed to a background thread that writes
+     them to a compact binary file.
+   - binary_log_decoder.cpp rebuilds the text lines offline.
+
+   Placeholders are "{}" and are filled in order.
+   A thread's records are written when its buffer fills up, when
+   the thread exits, when it calls flushThisThread(), and in any
+   case within one flush interval: the writer thread also takes
+   whatever a quiet thread has committed so far.
+
+   Build: g++ -std=c++20 -O2 -pthread binary_logger.cpp
+
+   File format (read by binary_log_decoder.cpp):
+     "BLOG2"
+     'D' varint id, u8 argCount, u8 types[argCount],
+         varint fmtLen, fmt bytes                  -- one per call site
+     'C' varint thread, varint byteLen, records   -- one per handoff
+   Record: varint id, varint nsSincePrevRecord of the same thread
+   (the thread's first record is absolute), then per arg:
+     Int    -> zigzag varint
+     UInt   -> varint
+     Double -> 8 raw bytes
+     String -> varint len, bytes
+   ========================================================== */
+
+using Clock = chrono::steady_clock;
+
+const size_t MAX_STRING_ARG = 1024;  // longer string arguments are truncated
+const size_t THREAD_BUFFER_BYTES = 64 * 1024;
+
+// ---------------- Encoding helpers -----------------
+
+inline char* putVarint(char* p, uint64_t v) {
+    while (v >= 0x80) {
+        *p++ = char(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = char(v);
+    return p;
+}
+
+inline void appendVarint(vector<char>& out, uint64_t v) {
+    char tmp[10];
+    out.insert(out.end(), tmp, putVarint(tmp, v));
+}
+
+template <typename T>
+constexpr ArgType argTypeOf() {
+    using D = decay_t<T>;
+    if constexpr (is_integral_v<D> && is_unsigned_v<D>) return UInt;
+    else if constexpr (is_integral_v<D>) return Int;
+    else if constexpr (is_floating_point_v<D>) return Double;
+    else {
+        static_assert(is_convertible_v<D, string_view>, "BIN_LOG supports integers, floating point and strings");
+        return String;
+    }
+}
+
+template <typename T>
+size_t maxEncodedSize(const T& v) {
+    if constexpr (argTypeOf<T>() == String) return 10 + min(string_view(v).size(), MAX_STRING_ARG);
+    else return 10;
+}
+
+template <typename T>
+char* encodeArg(char* p, const T& v) {
+    if constexpr (argTypeOf<T>() == UInt) {
+        return putVarint(p, uint64_t(v));
+    } else if constexpr (argTypeOf<T>() == Int) {
+        return putVarint(p, zigzag(int64_t(v)));
+    } else if constexpr (argTypeOf<T>() == Double) {
+        double d = double(v);
+        memcpy(p, &d, sizeof d);
+        return p + sizeof d;
+    } else {
+        string_view s = string_view(v).substr(0, MAX_STRING_ARG);
+        p = putVarint(p, s.size());
+        memcpy(p, s.data(), s.size());
+        return p + s.size();
+    }
+}
+
+// One per BIN_LOG call site, created as a function-local static.
+struct LogSite {
+    const char* format;
+    uint32_t id = 0;
+    once_flag registered;
+    explicit LogSite(const char* f) : format(f) {}
+};
+
+class ThreadBuffer;
+
+// ---------------- Logger Singleton -----------------
+class BinaryLogger {
+private:
+    ofstream file;
+    mutex buffersMtx;              // guards `buffers`; taken before a buffer's lock
+    vector<ThreadBuffer*> buffers;
+    mutex mtx;                     // taken after a buffer's lock, never before
+    condition_variable wake;
+    deque<vector<char>> pending;   // dictionary entries and chunks, in order
+    uint32_t nextId = 1;
+    atomic<uint32_t> nextThread{0};
+    atomic<uint64_t> chunkBytes{0};
+    bool stopping = false;
+    chrono::milliseconds flushInterval{50};
+    thread writer;
+
+    static string& pendingPath() {
+        static string path = "app.blog";
+        return path;
+    }
+
+    BinaryLogger() : file(pendingPath(), ios::binary | ios::trunc) {
+        file.write("BLOG2", 5);
+        writer = thread(&BinaryLogger::writeLoop, this);
+    }
+
+    void enqueue(vector<char> bytes) {
+        lock_guard<mutex> lock(mtx);
+        pending.push_back(move(bytes));
+    }
+
+    void collectQuietThreads();
+
+    void writeLoop() {
+        unique_lock<mutex> lock(mtx);
+        while (true) {
+            wake.wait_for(lock, flushInterval, [&] { return stopping; });
+            lock.unlock();
+            collectQuietThreads();
+            lock.lock();
+
+            deque<vector<char>> batch;
+            batch.swap(pending);
+            bool stop = stopping;
+            lock.unlock();
+
+            for (const vector<char>& b : batch) file.write(b.data(), b.size());
+            if (!batch.empty()) file.flush();
+
+            lock.lock();
+            if (stop && pending.empty()) return;
+        }
+    }
+
+public:
+    // Must be called before the first log call; ignored afterwards.
+    static void configure(const string& path) { pendingPath() = path; }
+
+    static BinaryLogger* getInstance() {
+        static BinaryLogger instance;
+        return &instance;
+    }
+
+    ~BinaryLogger() {
+        {
+            lock_guard<mutex> lock(mtx);
+            stopping = true;
+        }
+        wake.notify_all();
+        writer.join();
+    }
+
+    // Called once per call site. The dictionary entry is queued before any
+    // chunk that can contain a record with this id.
+    uint32_t registerFormat(const char* format, initializer_list<ArgType> types) {
+        lock_guard<mutex> lock(mtx);
+        uint32_t id = nextId++;
+        vector<char> entry{'D'};
+        appendVarint(entry, id);
+        entry.push_back(char(types.size()));
+        for (ArgType t : types) entry.push_back(char(t));
+        size_t len = strlen(format);
+        appendVarint(entry, len);
+        entry.insert(entry.end(), format, format + len);
+        pending.push_back(move(entry));
+        return id;
+    }
+
+    uint32_t addThread(ThreadBuffer* buffer) {
+        lock_guard<mutex> lock(buffersMtx);
+        buffers.push_back(buffer);
+        return nextThread.fetch_add(1, memory_order_relaxed);
+    }
+
+    void removeThread(ThreadBuffer* buffer);
+
+    void submitChunk(uint32_t threadIndex, const char* data, size_t size) {
+        vector<char> chunk;
+        chunk.reserve(size + 11);
+        chunk.push_back('C');
+        appendVarint(chunk, threadIndex);
+        appendVarint(chunk, size);
+        chunk.insert(chunk.end(), data, data + size);
+        chunkBytes.fetch_add(chunk.size(), memory_order_relaxed);
+        enqueue(move(chunk));
+    }
+
+    uint64_t bytesSubmitted() const { return chunkBytes.load(memory_order_relaxed); }
+
+    static void flushThisThread();
+
+    BinaryLogger(const BinaryLogger&) = delete;
+    BinaryLogger& operator=(const BinaryLogger&) = delete;
+};
+
+// ---------------- Per-thread staging buffer -----------------
+// The owning thread appends records after `used` without locking and
+// publishes them with a release store. Bytes [taken, used) are ready to
+// be written; the writer thread hands them off under `handoff`, so a
+// quiet thread's records do not sit in the buffer indefinitely.
+class ThreadBuffer {
+public:
+    static const size_t CAPACITY = THREAD_BUFFER_BYTES;
+
+private:
+    char data[CAPACITY];
+    atomic<size_t> used{0};
+    size_t taken = 0;       // guarded by handoff
+    mutex handoff;
+    uint32_t threadIndex;
+
+public:
+    uint64_t lastTimestamp = 0;
+
+    ThreadBuffer() : threadIndex(BinaryLogger::getInstance()->addThread(this)) {}
+    ~ThreadBuffer() { BinaryLogger::getInstance()->removeThread(this); }
+
+    // Submits the committed bytes not handed off yet. Any thread.
+    void handOff() {
+        lock_guard<mutex> lock(handoff);
+        size_t end = used.load(memory_order_acquire);
+        if (end > taken) BinaryLogger::getInstance()->submitChunk(threadIndex, data + taken, end - taken);
+        taken = end;
+    }
+
+    // Owning thread only: hands off everything and starts the buffer over.
+    void flush() {
+        lock_guard<mutex> lock(handoff);
+        size_t end = used.load(memory_order_relaxed);
+        if (end > taken) BinaryLogger::getInstance()->submitChunk(threadIndex, data + taken, end - taken);
+        used.store(0, memory_order_relaxed);
+        taken = 0;
+    }
+
+    // Returns a pointer with at least `bytes` free, flushing first if needed.
+    char* reserve(size_t bytes) {
+        if (used.load(memory_order_relaxed) + bytes > CAPACITY) flush();
+        return data + used.load(memory_order_relaxed);
+    }
+    void commit(char* end) { used.store(end - data, memory_order_release); }
+
+    static ThreadBuffer& local() {
+        thread_local ThreadBuffer buffer;
+        return buffer;
+    }
+};
+
+void BinaryLogger::flushThisThread() { ThreadBuffer::local().flush(); }
+
+// Runs on the writer thread once per flush interval.
+void BinaryLogger::collectQuietThreads() {
+    lock_guard<mutex> lock(buffersMtx);
+    for (ThreadBuffer* b : buffers) b->handOff();
+}
+
+void BinaryLogger::removeThread(ThreadBuffer* buffer) {
+    lock_guard<mutex> lock(buffersMtx);
+    buffer->flush();
+    buffers.erase(find(buffers.begin(), buffers.end(), buffer));
+}
+
+inline uint64_t nowNs() {
+    return chrono::duration_cast<chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// Hot path: no formatting, no locks, no allocation.
+template <typename... Args>
+void binLog(LogSite& site, const Args&... args) {
+    // Worst case: id + time varints, then every arg at its largest.
+    static_assert(20 + sizeof...(Args) * (10 + MAX_STRING_ARG) <= ThreadBuffer::CAPACITY,
+                  "too many arguments for one BIN_LOG record");
+    call_once(site.registered, [&] {
+        site.id = BinaryLogger::getInstance()->registerFormat(site.format, {argTypeOf<Args>()...});
+    });
+
+    ThreadBuffer& tb = ThreadBuffer::local();
+    size_t bound = 20 + (size_t(0) + ... + maxEncodedSize(args));
+    char* p = tb.reserve(bound);
+
+    uint64_t now = nowNs();
+    p = putVarint(p, site.id);
+    p = putVarint(p, now - tb.lastTimestamp);
+    tb.lastTimestamp = now;
+    ((p = encodeArg(p, args)), ...);
+    tb.commit(p);
+}
+
+#define BIN_LOG(fmt, ...)                                 \
+    do {                                                  \
+        static LogSite binLogSite_(fmt);                  \
+        binLog(binLogSite_ __VA_OPT__(,) __VA_ARGS__);    \
+    } while (0)
+
+// ---------------- Benchmark -----------------
+
+// README approach: format to text on the caller, one line per flush.
+class TextLogger {
+private:
+    ofstream logFile;
+
+public:
+    explicit TextLogger(const string& path) : logFile(path, ios::trunc) {}
+
+    void writeLog(const string& message) { logFile << message << endl; }
+};
+
+long fileSize(const string& path) {
+    ifstream in(path, ios::binary | ios::ate);
+    return in ? (long)in.tellg() : 0;
+}
+
+int main() {
+    BinaryLogger::configure("app.blog");
+
+    BIN_LOG("Application started");
+    BIN_LOG("User {} logged in from {}", 42, "10.0.0.7");
+    BIN_LOG("Order {} filled: qty={} price={}", 900001, 100, 101.25);
+    BIN_LOG("Account {} balance={} limit={}", uint64_t(18446744073709551000ull), 1234567.25, -1);
+
+    const int N = 1000000;
+    cout << "=== " << N << " log calls, single thread ===\n";
+
+    // 1. README writeLog(): format + endl
+    double textNs;
+    long textBytes;
+    {
+        TextLogger text("bench_text.log");
+        char line[128];
+        auto start = Clock::now();
+        for (int i = 0; i < N; i++) {
+            snprintf(line, sizeof line, "%llu Order %d filled: qty=%d price=%.2f venue=%s",
+                     (unsigned long long)nowNs(), 900001 + i, 100 + i % 50, 101.25 + i % 7, "NYSE");
+            text.writeLog(line);
+        }
+        textNs = chrono::duration<double, nano>(Clock::now() - start).count() / N;
+    }
+    textBytes = fileSize("bench_text.log");
+    remove("bench_text.log");
+
+    // 2. Binary deferred formatting
+    BinaryLogger::flushThisThread();
+    uint64_t before = BinaryLogger::getInstance()->bytesSubmitted();
+    auto start = Clock::now();
+    for (int i = 0; i < N; i++) {
+        BIN_LOG("Order {} filled: qty={} price={} venue={}", 900001 + i, 100 + i % 50, 101.25 + i % 7, "NYSE");
+    }
+    double binNs = chrono::duration<double, nano>(Clock::now() - start).count() / N;
+    BinaryLogger::flushThisThread();
+    uint64_t binBytes = BinaryLogger::getInstance()->bytesSubmitted() - before;
+
+    cout << "Text writeLog() : " << textNs << " ns/call, " << textBytes / N << " bytes/line\n";
+    cout << "Binary BIN_LOG  : " << binNs << " ns/call, " << binBytes / N << " bytes/record\n";
+    cout << "Decode with: ./binary_log_decoder app.blog\n";
+    return 0;
+}
+
+/* ==========================================================
+   SAMPLE OUTPUT (g++ -std=c++20 -O2; numbers depend on the machine)
+   ----------------------------------------------------------
+   === 1000000 log calls, single thread ===
+   Text writeLog() : 1610.87 ns/call, 67 bytes/line
+   Binary BIN_LOG  : 72.5522 ns/call, 20 bytes/record
+   Decode with: ./binary_log_decoder app.blog
+
+   Most of the remaining BIN_LOG cost is reading the clock.
+   ========================================================== */
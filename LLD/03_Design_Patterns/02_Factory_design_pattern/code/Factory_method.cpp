@@ -1,8 +1,11 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include "../../common/instrumentation.h"
 using namespace std;
 
+// Build: g++ -std=c++20 Factory_method.cpp   (-DINSTRUMENTATION_OFF compiles the metrics out)
+
 // Product Interface
 class Burger {
 public:
@@ -14,14 +17,14 @@ public:
 class BasicBurger : public Burger {
 public:
     void prepare() override {
-        cout << "Preparing Basic Burger with bun and patty." << endl;
+        EVENT_LOG("Preparing Basic Burger with bun and patty.");
     }
 };
 
 class StandardBurger : public Burger {
 public:
     void prepare() override {
-        cout << "Preparing Standard Burger with bun, patty, cheese, and lettuce." << endl;
+        EVENT_LOG("Preparing Standard Burger with bun, patty, cheese, and lettuce.");
     }
 };
 
@@ -29,14 +32,14 @@ public:
 class BasicWheatBurger : public Burger {
 public:
     void prepare() override {
-        cout << "Preparing Basic Wheat Burger with whole wheat bun and patty." << endl;
+        EVENT_LOG("Preparing Basic Wheat Burger with whole wheat bun and patty.");
     }
 };
 
 class StandardWheatBurger : public Burger {
 public:
     void prepare() override {
-        cout << "Preparing Standard Wheat Burger with whole wheat bun, patty, cheese, and lettuce." << endl;
+        EVENT_LOG("Preparing Standard Wheat Burger with whole wheat bun, patty, cheese, and lettuce.");
     }
 };
 
@@ -51,6 +54,7 @@ public:
 class SyncBurgerFactory : public BurgerFactory {
 public:
     unique_ptr<Burger> createBurger(const string& type) override {
+        TIME_SCOPE("factory.createBurger");
         if (type == "Basic") return make_unique<BasicBurger>();
         if (type == "Standard") return make_unique<StandardBurger>();
         throw invalid_argument("Invalid burger type for SyncBurger");
@@ -61,6 +65,7 @@ public:
 class KingBurgerFactory : public BurgerFactory {
 public:
     unique_ptr<Burger> createBurger(const string& type) override {
+        TIME_SCOPE("factory.createBurger");
         if (type == "Basic") return make_unique<BasicWheatBurger>();
         if (type == "Standard") return make_unique<StandardWheatBurger>();
         throw invalid_argument("Invalid burger type for KingBurger");
@@ -69,6 +74,7 @@ public:
 
 // Client Code
 int main() {
+    MetricsRegistry::instance().addConsoleSink();
     unique_ptr<BurgerFactory> factory = make_unique<KingBurgerFactory>();
     auto burger = factory->createBurger("Basic");
     burger->prepare();
@@ -1,8 +1,11 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include "../../common/instrumentation.h"
 using namespace std;
 
+// Build: g++ -std=c++20 Simple_factory.cpp   (-DINSTRUMENTATION_OFF compiles the metrics out)
+
 // Product Interface
 class Burger {
 public:
@@ -14,21 +17,21 @@ public:
 class BasicBurger : public Burger {
 public:
     void prepare() override {
-        cout << "Preparing Basic Burger with bun and patty." << endl;
+        EVENT_LOG("Preparing Basic Burger with bun and patty.");
     }
 };
 
 class StandardBurger : public Burger {
 public:
     void prepare() override {
-        cout << "Preparing Standard Burger with bun, patty, cheese, and lettuce." << endl;
+        EVENT_LOG("Preparing Standard Burger with bun, patty, cheese, and lettuce.");
     }
 };
 
 class PremiumBurger : public Burger {
 public:
     void prepare() override {
-        cout << "Preparing Premium Burger with gourmet bun, double patty, and special sauce." << endl;
+        EVENT_LOG("Preparing Premium Burger with gourmet bun, double patty, and special sauce.");
     }
 };
 
@@ -36,6 +39,7 @@ public:
 class BurgerFactory {
 public:
     static unique_ptr<Burger> createBurger(const string& type) {
+        TIME_SCOPE("factory.createBurger");
         if (type == "Basic") return make_unique<BasicBurger>();
         if (type == "Standard") return make_unique<StandardBurger>();
         if (type == "Premium") return make_unique<PremiumBurger>();
@@ -45,6 +49,7 @@ public:
 
 // Client Code
 int main() {
+    MetricsRegistry::instance().addConsoleSink();
     auto burger = BurgerFactory::createBurger("Standard");
     burger->prepare();
 }
\ No newline at end of file
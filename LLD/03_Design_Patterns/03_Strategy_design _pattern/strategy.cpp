@@ -1,6 +1,9 @@
 #include <iostream>
+#include "../common/instrumentation.h"
 using namespace std;
 
+// Build: g++ -std=c++20 strategy.cpp   (-DINSTRUMENTATION_OFF compiles the metrics out)
+
 // --- Strategy Interface for Walk ---
 class WalkableRobot {
 public:
@@ -12,14 +15,16 @@ public:
 class NormalWalk : public WalkableRobot {
 public:
     void walk() override { 
-        cout << "Walking normally..." << endl; 
+        COUNT_EVENT("robot.walk");
+        EVENT_LOG("Walking normally...");
     }
 };
 
 class NoWalk : public WalkableRobot {
 public:
     void walk() override { 
-        cout << "Cannot walk." << endl; 
+        COUNT_EVENT("robot.walk.none");
+        EVENT_LOG("Cannot walk.");
     }
 };
 
@@ -35,14 +40,16 @@ public:
 class NormalTalk : public TalkableRobot {
 public:
     void talk() override { 
-        cout << "Talking normally..." << endl; 
+        COUNT_EVENT("robot.talk");
+        EVENT_LOG("Talking normally...");
     }
 };
 
 class NoTalk : public TalkableRobot {
 public:
     void talk() override { 
-        cout << "Cannot talk." << endl; 
+        COUNT_EVENT("robot.talk.none");
+        EVENT_LOG("Cannot talk.");
     }
 };
 
@@ -56,14 +63,16 @@ public:
 class NormalFly : public FlyableRobot {
 public:
     void fly() override { 
-        cout << "Flying normally..." << endl; 
+        COUNT_EVENT("robot.fly");
+        EVENT_LOG("Flying normally...");
     }
 };
 
 class NoFly : public FlyableRobot {
 public:
     void fly() override { 
-        cout << "Cannot fly." << endl; 
+        COUNT_EVENT("robot.fly.none");
+        EVENT_LOG("Cannot fly.");
     }
 };
 
@@ -82,12 +91,15 @@ public:
     }
        
     void walk() { 
+        TIME_SCOPE("robot.walk.time");
         walkBehavior->walk(); 
     }
     void talk() { 
+        TIME_SCOPE("robot.talk.time");
         talkBehavior->talk(); 
     }
     void fly() { 
+        TIME_SCOPE("robot.fly.time");
         flyBehavior->fly(); 
     }
 
@@ -101,7 +113,7 @@ public:
         : Robot(w, t, f) {}
 
     void projection() override {
-        cout << "Displaying friendly companion features..." << endl;
+        EVENT_LOG("Displaying friendly companion features...");
     }
 };
 
@@ -111,12 +123,14 @@ public:
         : Robot(w, t, f) {}
 
     void projection() override {
-        cout << "Displaying worker efficiency stats..." << endl;
+        EVENT_LOG("Displaying worker efficiency stats...");
     }
 };
 
 // --- Main Function ---
 int main() {
+    MetricsRegistry::instance().addConsoleSink();
+
     Robot *robot1 = new CompanionRobot(new NormalWalk(), new NormalTalk(), new NoFly());
     robot1->walk();
     robot1->talk();
@@ -2,6 +2,7 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include "../../common/instrumentation.h"
 using namespace std;
 
 /* ==========================================================
@@ -12,6 +13,12 @@ using namespace std;
    - StockMarket (Subject) publishes stock price changes.
    - Multiple apps/services (Observers) like MobileApp,
      DesktopApp, NewsAgency want real-time updates.
+
+   Events go through ../../common/instrumentation.h: counted and
+   timed always, printed only because main() adds a console sink.
+
+   Build: g++ -std=c++20 observer_design.cpp
+          (add -DINSTRUMENTATION_OFF to compile the metrics out)
    ========================================================== */
 
 // ---------------- Observer Interface -----------------
@@ -46,6 +53,7 @@ public:
 
     // Notify all observers about stock price change
     void notifyObservers(const string& stockName, float price) override {
+        TIME_SCOPE("stock.notifyObservers");
         for (Observer* obs : observers) {
             obs->update(stockName, price);
         }
@@ -53,8 +61,8 @@ public:
 
     // Change stock price and broadcast to observers
     void setStockPrice(const string& stockName, float price) {
-        cout << "\n[StockMarket] " << stockName 
-             << " new price: $" << price << endl;
+        COUNT_EVENT("stock.priceChanges");
+        EVENT_LOG("\n[StockMarket] " << stockName << " new price: $" << price);
         notifyObservers(stockName, price);
     }
 };
@@ -69,8 +77,8 @@ public:
     MobileApp(string name) : owner(name) {}
 
     void update(const string& stockName, float price) override {
-        cout << "[MobileApp - " << owner << "] "
-             << stockName << " updated price: $" << price << endl;
+        COUNT_EVENT("observer.mobileApp");
+        EVENT_LOG("[MobileApp - " << owner << "] " << stockName << " updated price: $" << price);
     }
 };
 
@@ -78,8 +86,8 @@ public:
 class DesktopApp : public Observer {
 public:
     void update(const string& stockName, float price) override {
-        cout << "[DesktopApp] Displaying " 
-             << stockName << " price: $" << price << endl;
+        COUNT_EVENT("observer.desktopApp");
+        EVENT_LOG("[DesktopApp] Displaying " << stockName << " price: $" << price);
     }
 };
 
@@ -87,13 +95,16 @@ public:
 class NewsAgency : public Observer {
 public:
     void update(const string& stockName, float price) override {
-        cout << "[NewsAgency] Breaking news: "
-             << stockName << " hits $" << price << endl;
+        COUNT_EVENT("observer.newsAgency");
+        EVENT_LOG("[NewsAgency] Breaking news: " << stockName << " hits $" << price);
     }
 };
 
 // ---------------- Client Code -----------------
 int main() {
+    // Print the events as they happen (the hot path itself never touches cout)
+    MetricsRegistry::instance().addConsoleSink();
+
     // Create StockMarket (Subject)
     StockMarket market;
 
@@ -0,0 +1,94 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <stdexcept>
+using namespace std;
+
+// --- Adaptee: legacy customer store (old C-style interface) ---
+struct LegacyRecord {
+    char fullName[32];
+    char city[24];
+    int ageYears;
+    long balanceCents;
+};
+
+class LegacyCustomerStore {
+    vector<LegacyRecord> records;
+public:
+    void add(const char* name, const char* city, int age, long cents) {
+        LegacyRecord r{};
+        strncpy(r.fullName, name, sizeof(r.fullName) - 1);
+        strncpy(r.city, city, sizeof(r.city) - 1);
+        r.ageYears = age;
+        r.balanceCents = cents;
+        records.push_back(r);
+    }
+
+    // Old API: copy record #index into the caller's struct, return 0 on success
+    int fetchRecord(int index, LegacyRecord* out) const {
+        if (index < 0 || index >= (int)records.size()) return -1;
+        *out = records[index];
+        return 0;
+    }
+
+    int recordCount() const { return (int)records.size(); }
+};
+
+// --- Target: the interface our new code expects ---
+struct Customer {
+    string name;
+    string city;
+    int age;
+    double balance;  // in rupees
+};
+
+class CustomerRepository {
+public:
+    virtual size_t size() const = 0;
+    virtual Customer get(size_t i) const = 0;
+    virtual ~CustomerRepository() {}
+};
+
+// --- Adapter: makes the legacy store look like a CustomerRepository ---
+class LegacyCustomerAdapter : public CustomerRepository {
+    const LegacyCustomerStore* store;
+public:
+    LegacyCustomerAdapter(const LegacyCustomerStore* s) : store(s) {}
+
+    size_t size() const override { return store->recordCount(); }
+
+    Customer get(size_t i) const override {
+        LegacyRecord r;
+        if (store->fetchRecord((int)i, &r) != 0) throw out_of_range("No such customer");
+        return Customer{r.fullName, r.city, r.ageYears, r.balanceCents / 100.0};
+    }
+};
+
+// --- Client: only knows about CustomerRepository ---
+void printCustomers(const CustomerRepository& repo) {
+    for (size_t i = 0; i < repo.size(); i++) {
+        Customer c = repo.get(i);
+        cout << c.name << " (" << c.age << ", " << c.city << ") balance: " << c.balance << endl;
+    }
+}
+
+int main() {
+    LegacyCustomerStore legacy;
+    legacy.add("Asha Kulkarni", "Pune", 34, 1250050);
+    legacy.add("Rahul Verma", "Delhi", 41, 89900);
+
+    LegacyCustomerAdapter adapter(&legacy);
+    printCustomers(adapter);
+    return 0;
+}
+
+// Output:
+// Asha Kulkarni (34, Pune) balance: 12500.5
+// Rahul Verma (41, Delhi) balance: 899
+
+// ---Advantages:---
+// 1. Client code works with the new interface only; the legacy store is untouched.
+// 2. Swapping the legacy store for a new database only means writing a new adapter.
+// 3. All conversion logic (char arrays -> string, cents -> rupees) lives in one place.
+// See adapter_benchmark.cpp for what this per-call conversion costs on a hot path.
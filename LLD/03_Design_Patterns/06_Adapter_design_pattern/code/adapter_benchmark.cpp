@@ -0,0 +1,251 @@
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <span>
+#include <algorithm>
+#include <memory>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+#include <stdexcept>
+using namespace std;
+
+/* ==========================================================
+   ADAPTER ON A HOT PATH - what does it cost?
+   ----------------------------------------------------------
+   Same legacy store as adapter.cpp, untouched: the only way in
+   is fetchRecord(), which copies a record into the caller's
+   struct. Every version below pays that one copy. The client
+   scans millions of customers and sums the balances of those in
+   one city.
+
+   1. Direct       : client calls the legacy fetchRecord() itself
+   2. Naive adapter: get(i) converts every record into a Customer
+                     with two std::string members (2 allocations)
+   3. Single-copy  : getBorrowed(i) copies the record once, into
+                     a buffer the adapter owns, and returns
+                     string_views into that buffer - no allocation;
+                     valid until the next call
+   4. Batch adapter: readBatch() fetches a whole block into the
+                     adapter's buffer and returns views with ONE
+                     virtual call
+
+   Each line is the median of REPEATS scans.
+
+   Build: g++ -std=c++20 -O2 adapter_benchmark.cpp
+   ========================================================== */
+
+using Clock = chrono::steady_clock;
+
+// --- Adaptee ---
+struct LegacyRecord {
+    char fullName[32];
+    char city[24];
+    int ageYears;
+    long balanceCents;
+};
+
+class LegacyCustomerStore {
+    vector<LegacyRecord> records;
+public:
+    void add(const char* name, const char* city, int age, long cents) {
+        LegacyRecord r{};
+        strncpy(r.fullName, name, sizeof(r.fullName) - 1);
+        strncpy(r.city, city, sizeof(r.city) - 1);
+        r.ageYears = age;
+        r.balanceCents = cents;
+        records.push_back(r);
+    }
+
+    // Old API: copy record #index into the caller's struct, return 0 on success
+    int fetchRecord(int index, LegacyRecord* out) const {
+        if (index < 0 || index >= (int)records.size()) return -1;
+        *out = records[index];
+        return 0;
+    }
+
+    int recordCount() const { return (int)records.size(); }
+};
+
+// --- Target interfaces ---
+struct Customer {                 // owning copy
+    string name;
+    string city;
+    int age;
+    double balance;
+};
+
+struct CustomerView {             // borrowed from the adapter, valid until its next call
+    string_view name;
+    string_view city;
+    int age;
+    long balanceCents;
+};
+
+class CustomerRepository {
+public:
+    virtual size_t size() const = 0;
+    virtual Customer get(size_t i) const = 0;
+    virtual CustomerView getBorrowed(size_t i) = 0;
+    // Fills `out` with views of records [start, start + out.size()); returns how many.
+    virtual size_t readBatch(size_t start, span<CustomerView> out) = 0;
+    virtual ~CustomerRepository() {}
+};
+
+// --- Adapter ---
+// Not thread-safe: views point into the adapter's own buffers.
+class LegacyCustomerAdapter : public CustomerRepository {
+    const LegacyCustomerStore* store;
+    LegacyRecord current;            // backs getBorrowed()
+    vector<LegacyRecord> block;      // backs readBatch()
+
+    void fetch(size_t i, LegacyRecord* out) const {
+        if (store->fetchRecord((int)i, out) != 0) throw out_of_range("No such customer");
+    }
+
+    static CustomerView view(const LegacyRecord& r) {
+        return {string_view(r.fullName, strnlen(r.fullName, sizeof r.fullName)),
+                string_view(r.city, strnlen(r.city, sizeof r.city)),
+                r.ageYears, r.balanceCents};
+    }
+
+public:
+    LegacyCustomerAdapter(const LegacyCustomerStore* s) : store(s) {}
+
+    size_t size() const override { return store->recordCount(); }
+
+    // Naive: copy out of the legacy store, then copy again into strings.
+    Customer get(size_t i) const override {
+        LegacyRecord r;
+        fetch(i, &r);
+        return Customer{r.fullName, r.city, r.ageYears, r.balanceCents / 100.0};
+    }
+
+    // One copy (the one fetchRecord() makes anyway); the strings are views into it.
+    CustomerView getBorrowed(size_t i) override {
+        fetch(i, &current);
+        return view(current);
+    }
+
+    size_t readBatch(size_t start, span<CustomerView> out) override {
+        size_t total = size();
+        size_t n = min(out.size(), total - min(start, total));
+        if (block.size() < n) block.resize(n);
+        for (size_t k = 0; k < n; k++) {
+            fetch(start + k, &block[k]);
+            out[k] = view(block[k]);
+        }
+        return n;
+    }
+};
+
+// --- Benchmark ---
+
+const int REPEATS = 5;
+
+// Median ns/record over REPEATS scans; `total` gets the scan's result.
+template <typename Fn>
+double measure(size_t records, double& total, Fn fn) {
+    vector<double> ns;
+    for (int r = 0; r < REPEATS; r++) {
+        auto start = Clock::now();
+        total = fn();
+        ns.push_back(chrono::duration<double, nano>(Clock::now() - start).count() / records);
+    }
+    sort(ns.begin(), ns.end());
+    return ns[REPEATS / 2];
+}
+
+template <typename Fn>
+void bench(const string& name, size_t records, double baselineNs, Fn fn) {
+    double total;
+    double ns = measure(records, total, fn);
+    printf("%-15s %6.2f ns/record  (+%5.2f ns adapter tax)  sum=%.2f\n",
+           name.c_str(), ns, ns - baselineNs, total);
+}
+
+int main() {
+    const size_t N = 4000000;
+    const char* cities[] = {"Pune", "Delhi", "Mumbai", "Chennai"};
+    const char* names[] = {"Asha Kulkarni-Deshpande", "Rahul Verma Sharma", "Priya Raghunathan Iyer"};
+
+    LegacyCustomerStore legacy;
+    for (size_t i = 0; i < N; i++) {
+        legacy.add(names[i % 3], cities[i % 4], 18 + int(i % 60), long(i % 100000));
+    }
+
+    // Chosen at runtime so the compiler cannot skip the virtual calls.
+    unique_ptr<CustomerRepository> repo = make_unique<LegacyCustomerAdapter>(&legacy);
+    const string_view target = "Pune";
+
+    cout << "=== Sum balances of customers in Pune, " << N << " records ===\n";
+
+    double directTotal;
+    double directNs = measure(N, directTotal, [&] {
+        double total = 0;
+        LegacyRecord r;
+        for (int i = 0; i < legacy.recordCount(); i++) {
+            if (legacy.fetchRecord(i, &r) != 0) break;
+            if (strcmp(r.city, "Pune") == 0) total += r.balanceCents / 100.0;
+        }
+        return total;
+    });
+    printf("%-15s %6.2f ns/record  (baseline)                  sum=%.2f\n", "Direct", directNs, directTotal);
+
+    bench("Naive adapter", N, directNs, [&] {
+        double total = 0;
+        for (size_t i = 0; i < repo->size(); i++) {
+            Customer c = repo->get(i);
+            if (c.city == target) total += c.balance;
+        }
+        return total;
+    });
+
+    bench("Single-copy", N, directNs, [&] {
+        long cents = 0;
+        for (size_t i = 0; i < repo->size(); i++) {
+            CustomerView c = repo->getBorrowed(i);
+            if (c.city == target) cents += c.balanceCents;
+        }
+        return cents / 100.0;
+    });
+
+    bench("Batch adapter", N, directNs, [&] {
+        long cents = 0;
+        CustomerView batch[256];
+        size_t n;
+        for (size_t start = 0; (n = repo->readBatch(start, batch)) > 0; start += n) {
+            for (size_t k = 0; k < n; k++) {
+                if (batch[k].city == target) cents += batch[k].balanceCents;
+            }
+        }
+        return cents / 100.0;
+    });
+
+    return 0;
+}
+
+/* ==========================================================
+   SAMPLE OUTPUT (g++ -std=c++20 -O2; numbers depend on the machine)
+   ----------------------------------------------------------
+   === Sum balances of customers in Pune, 4000000 records ===
+   Direct            8.46 ns/record  (baseline)                  sum=499980000.00
+   Naive adapter    50.08 ns/record  (+41.62 ns adapter tax)  sum=499980000.00
+   Single-copy      14.95 ns/record  (+ 6.49 ns adapter tax)  sum=499980000.00
+   Batch adapter    17.50 ns/record  (+ 9.04 ns adapter tax)  sum=499980000.00
+
+   Takeaways:
+   - All four pay the same fetchRecord() copy. Almost all of the
+     naive adapter's extra cost is the two string allocations per
+     record; views into the adapter's one copy remove it.
+   - What is left (~6 ns) is the virtual call, the not-found check
+     and measuring both strings (strnlen), where Direct only runs
+     strcmp on the city.
+   - A virtual call to the same target every time is cheap (well
+     predicted), so here batching does not beat one call per record:
+     the batch still calls fetchRecord() per record, and writing
+     the views out costs about as much as the calls it saves.
+     Batching pays off when each call to the adaptee is expensive
+     (a lock, a syscall, a network hop).
+   ========================================================== */
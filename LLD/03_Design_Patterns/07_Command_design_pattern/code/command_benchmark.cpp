@@ -0,0 +1,190 @@
+#include <string>
+#include <stack>
+#include "../../common/pattern_bench.h"
+using namespace std;
+
+/* ==========================================================
+   COMMAND - without vs with, measured
+   ----------------------------------------------------------
+   Same remotes as without_cmd_pattern.cpp and with_cmd_pattern.cpp.
+   The devices no longer print "Light is ON"; they count what
+   happened instead, so we measure the dispatch and not cout.
+
+   Measured per button press (cycling light on/off, tv on/off):
+   - without/press      : pressButton("light", "on") -> string
+                          compares -> device
+   - with/press         : setCommand + pressButton -> virtual
+                          execute() + push on the undo history
+   - with/press+undo    : press, then undo it
+
+   Build: g++ -std=c++20 -O2 command_benchmark.cpp
+   Run  : ./a.out > command.json
+   ========================================================== */
+
+// --- Receivers: counters instead of cout ---
+class Light {
+public:
+    bool isOn = false;
+    uint64_t switches = 0;
+    void on() { isOn = true; switches++; }
+    void off() { isOn = false; switches++; }
+};
+
+class TV {
+public:
+    bool isOn = false;
+    uint64_t switches = 0;
+    void on() { isOn = true; switches++; }
+    void off() { isOn = false; switches++; }
+};
+
+// ---------------- Without command pattern ----------------
+namespace without {
+
+class RemoteControl {
+public:
+    void pressButton(string device, string action) {
+        if (device == "light") {
+            if (action == "on") light.on();
+            else if (action == "off") light.off();
+        } else if (device == "tv") {
+            if (action == "on") tv.on();
+            else if (action == "off") tv.off();
+        }
+    }
+
+    Light light;
+    TV tv;
+};
+
+}  // namespace without
+
+// ---------------- With command pattern ----------------
+namespace with {
+
+class Command {
+public:
+    virtual void execute() = 0;
+    virtual void undo() = 0;
+    virtual ~Command() {}
+};
+
+class LightOnCommand : public Command {
+    Light* light;
+public:
+    LightOnCommand(Light* l) : light(l) {}
+    void execute() override { light->on(); }
+    void undo() override { light->off(); }
+};
+
+class LightOffCommand : public Command {
+    Light* light;
+public:
+    LightOffCommand(Light* l) : light(l) {}
+    void execute() override { light->off(); }
+    void undo() override { light->on(); }
+};
+
+class TVOnCommand : public Command {
+    TV* tv;
+public:
+    TVOnCommand(TV* t) : tv(t) {}
+    void execute() override { tv->on(); }
+    void undo() override { tv->off(); }
+};
+
+class TVOffCommand : public Command {
+    TV* tv;
+public:
+    TVOffCommand(TV* t) : tv(t) {}
+    void execute() override { tv->off(); }
+    void undo() override { tv->on(); }
+};
+
+class RemoteControl {
+    Command* command;
+    stack<Command*> history;
+public:
+    void setCommand(Command* cmd) { command = cmd; }
+
+    void pressButton() {
+        command->execute();
+        history.push(command);
+    }
+
+    void pressUndo() {
+        if (!history.empty()) {
+            Command* lastCommand = history.top();
+            history.pop();
+            lastCommand->undo();
+        }
+    }
+};
+
+}  // namespace with
+
+int main() {
+    const uint64_t N = 10000000;
+    PatternBench bench("command");
+
+    // Which button the user presses next; read at runtime so nothing is folded away.
+    const char* devices[4] = {"light", "light", "tv", "tv"};
+    const char* actions[4] = {"on", "off", "on", "off"};
+    doNotOptimize(devices);
+    doNotOptimize(actions);
+
+    without::RemoteControl plainRemote;
+    uint64_t press = 0;
+    bench.run("without/press", N, [&] {
+        size_t k = press++ & 3;
+        plainRemote.pressButton(devices[k], actions[k]);
+    });
+
+    Light light;
+    TV tv;
+    with::LightOnCommand lightOn(&light);
+    with::LightOffCommand lightOff(&light);
+    with::TVOnCommand tvOn(&tv);
+    with::TVOffCommand tvOff(&tv);
+    with::Command* buttons[4] = {&lightOn, &lightOff, &tvOn, &tvOff};
+    doNotOptimize(buttons);
+
+    // The history grows by one entry per press, as in with_cmd_pattern.cpp.
+    with::RemoteControl remote;
+    press = 0;
+    bench.run("with/press", N, [&] {
+        remote.setCommand(buttons[press++ & 3]);
+        remote.pressButton();
+    });
+
+    with::RemoteControl undoRemote;
+    press = 0;
+    bench.run("with/press+undo", N, [&] {
+        undoRemote.setCommand(buttons[press++ & 3]);
+        undoRemote.pressButton();
+        undoRemote.pressUndo();
+    });
+
+    bench.report();
+    fprintf(stderr, "(switches: without %llu, with %llu)\n",
+            (unsigned long long)(plainRemote.light.switches + plainRemote.tv.switches),
+            (unsigned long long)(light.switches + tv.switches));
+    return 0;
+}
+
+/* ==========================================================
+   SAMPLE OUTPUT (stderr; numbers depend on the machine)
+   ----------------------------------------------------------
+   === command ===
+   without/press                       32.57 ns/op    0.00 allocs/op      0.0 B/op      n/a instr/op
+   with/press                           8.10 ns/op    0.02 allocs/op      8.5 B/op      n/a instr/op
+   with/press+undo                      5.24 ns/op    0.00 allocs/op      0.0 B/op      n/a instr/op
+
+   Takeaways:
+   - The pattern is FASTER here: without it, every press builds two
+     std::string arguments and compares them; with it, a press is
+     one virtual call.
+   - The undo history is the real cost: it grows by 8 bytes per
+     press forever (a new 512-byte block every 64 presses). Cap it
+     on a long-running hot path.
+   ========================================================== */
@@ -1,19 +1,22 @@
 #include <iostream>
 #include <stack>
+#include "../../common/instrumentation.h"
 using namespace std;
 
+// Build: g++ -std=c++20 with_cmd_pattern.cpp   (-DINSTRUMENTATION_OFF compiles the metrics out)
+
 
 // --- Receiver classes (actual devices) ---
 class Light {
 public:
-    void on() { cout << "Light is ON\n"; }
-    void off() { cout << "Light is OFF\n"; }
+    void on() { COUNT_EVENT("light.on"); EVENT_LOG("Light is ON"); }
+    void off() { COUNT_EVENT("light.off"); EVENT_LOG("Light is OFF"); }
 };
 
 class TV {
 public:
-    void on() { cout << "TV is ON\n"; }
-    void off() { cout << "TV is OFF\n"; }
+    void on() { COUNT_EVENT("tv.on"); EVENT_LOG("TV is ON"); }
+    void off() { COUNT_EVENT("tv.off"); EVENT_LOG("TV is OFF"); }
 };
 
 // --- Command interface ---
@@ -68,11 +71,13 @@ public:
     }
 
     void pressButton() {
+        TIME_SCOPE("remote.pressButton");
         command->execute();
         history.push(command);
     }
 
     void pressUndo() {
+        TIME_SCOPE("remote.pressUndo");
         if (!history.empty()) {
             Command* lastCommand = history.top();
             history.pop();
@@ -83,6 +88,8 @@ public:
 
 // --- Client code ---
 int main() {
+    MetricsRegistry::instance().addConsoleSink();
+
     Light light;
     TV tv;
 
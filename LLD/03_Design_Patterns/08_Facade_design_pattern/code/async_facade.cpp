@@ -0,0 +1,459 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <queue>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <coroutine>
+#include <exception>
+using namespace std;
+
+/* ==========================================================
+   ASYNC FACADE - C++20 COROUTINE HOME THEATER
+   ----------------------------------------------------------
+   Real devices answer slowly. The blocking facade in
+   with_facade.cpp would park a whole thread for the entire
+   watchMovie() sequence.
+
+   Here every device operation is awaitable:
+   - EventLoop   : one thread, a ready queue and a timer heap.
+   - DeviceOp    : completes when the (simulated) device answers,
+                   or with Timeout when the step deadline passes.
+   - CancelToken : cancels the step currently in flight and makes
+                   every later step finish immediately.
+   - Task        : coroutine type returned by watchMovie/endMovie.
+
+   Build: g++ -std=c++20 -O2 async_facade.cpp
+   ========================================================== */
+
+using Clock = chrono::steady_clock;
+
+enum class Status { Ok, Timeout, Cancelled };
+
+// State shared between a suspended step and everyone who may finish it
+// (device reply, timeout timer, cancellation). First one to arrive wins.
+struct PendingOp {
+    coroutine_handle<> handle;
+    bool done = false;
+    Status result = Status::Ok;
+};
+
+// ---------------- Event Loop -----------------
+class EventLoop {
+private:
+    struct Timer {
+        Clock::time_point when;
+        uint64_t seq;
+        shared_ptr<PendingOp> op;
+        Status result;
+    };
+    struct Later {
+        bool operator()(const Timer& a, const Timer& b) const {
+            return a.when != b.when ? a.when > b.when : a.seq > b.seq;
+        }
+    };
+
+    deque<coroutine_handle<>> ready;
+    priority_queue<Timer, vector<Timer>, Later> timers;
+    uint64_t nextSeq = 0;
+
+public:
+    void post(coroutine_handle<> h) { ready.push_back(h); }
+
+    // Finish `op` with `result` at `when`, unless someone else finished it first.
+    void completeAt(Clock::time_point when, shared_ptr<PendingOp> op, Status result) {
+        timers.push({when, nextSeq++, move(op), result});
+    }
+
+    void complete(const shared_ptr<PendingOp>& op, Status result) {
+        if (op->done) return;
+        op->done = true;
+        op->result = result;
+        post(op->handle);
+    }
+
+    void run() {
+        while (!ready.empty() || !timers.empty()) {
+            while (!ready.empty()) {
+                coroutine_handle<> h = ready.front();
+                ready.pop_front();
+                h.resume();
+            }
+            // Timers of ops that already finished (the timeout of a step that
+            // replied, the reply of a step that timed out) are dead: drop them
+            // instead of sleeping until they expire.
+            while (!timers.empty() && timers.top().op->done) timers.pop();
+            if (timers.empty()) break;
+
+            if (timers.top().when > Clock::now()) {
+                this_thread::sleep_until(timers.top().when);
+            }
+            Clock::time_point now = Clock::now();
+            while (!timers.empty() && timers.top().when <= now) {
+                Timer t = timers.top();
+                timers.pop();
+                complete(t.op, t.result);
+            }
+        }
+    }
+};
+
+// ---------------- Cancellation -----------------
+class CancelToken {
+private:
+    struct State {
+        bool cancelled = false;
+        shared_ptr<PendingOp> inFlight;
+    };
+    shared_ptr<State> state = make_shared<State>();
+    EventLoop* loop;
+
+public:
+    explicit CancelToken(EventLoop& l) : loop(&l) {}
+
+    void cancel() {
+        state->cancelled = true;
+        if (state->inFlight) loop->complete(state->inFlight, Status::Cancelled);
+    }
+
+    bool isCancelled() const { return state->cancelled; }
+    void attach(shared_ptr<PendingOp> op) const { state->inFlight = move(op); }
+    void detach() const { state->inFlight.reset(); }
+};
+
+// ---------------- Coroutine Task -----------------
+// Lazily started; resumes whoever awaited it when it finishes.
+class Task {
+public:
+    struct promise_type {
+        Status value = Status::Ok;
+        coroutine_handle<> continuation = noop_coroutine();
+
+        Task get_return_object() {
+            return Task(coroutine_handle<promise_type>::from_promise(*this));
+        }
+        suspend_always initial_suspend() noexcept { return {}; }
+
+        struct FinalAwaiter {
+            bool await_ready() noexcept { return false; }
+            coroutine_handle<> await_suspend(coroutine_handle<promise_type> h) noexcept {
+                return h.promise().continuation;
+            }
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_value(Status s) { value = s; }
+        void unhandled_exception() { terminate(); }
+    };
+
+    Task(Task&& other) noexcept : handle(other.handle) { other.handle = nullptr; }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() { if (handle) handle.destroy(); }
+
+    bool await_ready() const { return false; }
+    coroutine_handle<> await_suspend(coroutine_handle<> awaiting) {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+    Status await_resume() { return handle.promise().value; }
+
+private:
+    explicit Task(coroutine_handle<promise_type> h) : handle(h) {}
+    coroutine_handle<promise_type> handle;
+};
+
+// Fire-and-forget coroutine used to start top-level sequences.
+struct Detached {
+    struct promise_type {
+        Detached get_return_object() { return {}; }
+        suspend_never initial_suspend() noexcept { return {}; }
+        suspend_never final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { terminate(); }
+    };
+};
+
+// ---------------- Awaitable Device Operation -----------------
+class SimulatedDevice;
+
+class DeviceOp {
+private:
+    SimulatedDevice* device;
+    string command;
+    chrono::milliseconds timeout{0};
+    const CancelToken* token = nullptr;
+    shared_ptr<PendingOp> op;
+
+public:
+    DeviceOp(SimulatedDevice* d, string cmd) : device(d), command(move(cmd)) {}
+
+    DeviceOp& within(chrono::milliseconds t, const CancelToken& tok) {
+        timeout = t;
+        token = &tok;
+        return *this;
+    }
+
+    bool await_ready() const { return false; }
+    bool await_suspend(coroutine_handle<> h);
+    Status await_resume() {
+        if (token) token->detach();
+        return op ? op->result : Status::Cancelled;
+    }
+};
+
+// ---------------- Simulated Device Backend -----------------
+// Stands in for a real device: every command answers after
+// `latency` +/- `jitter`, and a flaky device sometimes never answers.
+class SimulatedDevice {
+private:
+    EventLoop& loop;
+    string name;
+    chrono::milliseconds latency;
+    chrono::milliseconds jitter;
+    double hangProbability;
+    mt19937 rng;
+
+public:
+    bool verbose = false;
+
+    SimulatedDevice(EventLoop& l, string n, chrono::milliseconds lat,
+                    chrono::milliseconds jit = chrono::milliseconds(0), double hang = 0.0,
+                    unsigned seed = 1)
+        : loop(l), name(move(n)), latency(lat), jitter(jit), hangProbability(hang), rng(seed) {}
+
+    EventLoop& eventLoop() { return loop; }
+
+    // Schedules the device's reply; returns false if this call will hang.
+    bool send(const string& command, const shared_ptr<PendingOp>& op) {
+        if (verbose) cout << "  -> " << name << " " << command << "\n";
+        if (uniform_real_distribution<double>(0.0, 1.0)(rng) < hangProbability) return false;
+        long j = jitter.count() ? uniform_int_distribution<long>(0, jitter.count())(rng) : 0;
+        loop.completeAt(Clock::now() + latency + chrono::milliseconds(j), op, Status::Ok);
+        return true;
+    }
+
+    DeviceOp call(string command) { return DeviceOp(this, move(command)); }
+};
+
+bool DeviceOp::await_suspend(coroutine_handle<> h) {
+    if (token && token->isCancelled()) return false;  // don't even start
+
+    op = make_shared<PendingOp>();
+    op->handle = h;
+    EventLoop& loop = device->eventLoop();
+    device->send(command, op);
+    loop.completeAt(Clock::now() + timeout, op, Status::Timeout);
+    if (token) token->attach(op);
+    return true;
+}
+
+// ---------------- Subsystem Classes (async) -----------------
+
+class DVDPlayer : public SimulatedDevice {
+public:
+    using SimulatedDevice::SimulatedDevice;
+    DeviceOp on() { return call("on"); }
+    DeviceOp play(const string& movie) { return call("play " + movie); }
+    DeviceOp stop() { return call("stop"); }
+    DeviceOp off() { return call("off"); }
+};
+
+class Projector : public SimulatedDevice {
+public:
+    using SimulatedDevice::SimulatedDevice;
+    DeviceOp on() { return call("on"); }
+    DeviceOp setInput(DVDPlayer*) { return call("setInput DVD"); }
+    DeviceOp off() { return call("off"); }
+};
+
+class Amplifier : public SimulatedDevice {
+public:
+    using SimulatedDevice::SimulatedDevice;
+    DeviceOp on() { return call("on"); }
+    DeviceOp setSource(DVDPlayer*) { return call("setSource DVD"); }
+    DeviceOp setVolume(int level) { return call("setVolume " + to_string(level)); }
+    DeviceOp off() { return call("off"); }
+};
+
+class Lights : public SimulatedDevice {
+public:
+    using SimulatedDevice::SimulatedDevice;
+    DeviceOp dim(int level) { return call("dim " + to_string(level) + "%"); }
+    DeviceOp on() { return call("on"); }
+};
+
+class Screen : public SimulatedDevice {
+public:
+    using SimulatedDevice::SimulatedDevice;
+    DeviceOp down() { return call("down"); }
+    DeviceOp up() { return call("up"); }
+};
+
+class PopcornMaker : public SimulatedDevice {
+public:
+    using SimulatedDevice::SimulatedDevice;
+    DeviceOp on() { return call("on"); }
+    DeviceOp pop() { return call("pop"); }
+    DeviceOp off() { return call("off"); }
+};
+
+// ---------------- Async Facade -----------------
+class AsyncHomeTheaterFacade {
+private:
+    DVDPlayer* dvd;
+    Projector* projector;
+    Amplifier* amp;
+    Lights* lights;
+    Screen* screen;
+    PopcornMaker* popcorn;
+    chrono::milliseconds stepTimeout;
+
+    // Runs the steps in order; stops at the first one that is not Ok.
+    Task runSteps(vector<DeviceOp> steps, CancelToken token) {
+        for (DeviceOp& step : steps) {
+            Status s = co_await step.within(stepTimeout, token);
+            if (s != Status::Ok) co_return s;
+        }
+        co_return Status::Ok;
+    }
+
+public:
+    AsyncHomeTheaterFacade(DVDPlayer* d, Projector* p, Amplifier* a,
+                           Lights* l, Screen* s, PopcornMaker* pm,
+                           chrono::milliseconds timeout)
+        : dvd(d), projector(p), amp(a), lights(l), screen(s), popcorn(pm),
+          stepTimeout(timeout) {}
+
+    Task watchMovie(const string& movie, CancelToken token) {
+        return runSteps({popcorn->on(), popcorn->pop(), lights->dim(10), screen->down(),
+                         projector->on(), projector->setInput(dvd),
+                         amp->on(), amp->setSource(dvd), amp->setVolume(5),
+                         dvd->on(), dvd->play(movie)},
+                        token);
+    }
+
+    Task endMovie(CancelToken token) {
+        return runSteps({popcorn->off(), lights->on(), screen->up(), projector->off(),
+                         amp->off(), dvd->stop(), dvd->off()},
+                        token);
+    }
+};
+
+// ---------------- Client Code -----------------
+
+struct Theater {
+    DVDPlayer dvd;
+    Projector projector;
+    Amplifier amp;
+    Lights lights;
+    Screen screen;
+    PopcornMaker popcorn;
+    AsyncHomeTheaterFacade facade;
+
+    Theater(EventLoop& loop, unsigned seed, double hang, chrono::milliseconds timeout)
+        : dvd(loop, "DVDPlayer", chrono::milliseconds(3), chrono::milliseconds(4), hang, seed),
+          projector(loop, "Projector", chrono::milliseconds(5), chrono::milliseconds(5), 0.0, seed + 1),
+          amp(loop, "Amplifier", chrono::milliseconds(2), chrono::milliseconds(3), 0.0, seed + 2),
+          lights(loop, "Lights", chrono::milliseconds(1)),
+          screen(loop, "Screen", chrono::milliseconds(4)),
+          popcorn(loop, "PopcornMaker", chrono::milliseconds(1)),
+          facade(&dvd, &projector, &amp, &lights, &screen, &popcorn, timeout) {}
+
+    void setVerbose(bool v) {
+        dvd.verbose = projector.verbose = amp.verbose = v;
+        lights.verbose = screen.verbose = popcorn.verbose = v;
+    }
+};
+
+struct Stats {
+    int ok = 0, timeout = 0, cancelled = 0;
+    void record(Status s) {
+        if (s == Status::Ok) ok++;
+        else if (s == Status::Timeout) timeout++;
+        else cancelled++;
+    }
+};
+
+Detached movieNight(Theater& t, string movie, CancelToken token, Stats& stats) {
+    Status s = co_await t.facade.watchMovie(movie, token);
+    if (s == Status::Ok) s = co_await t.facade.endMovie(token);
+    stats.record(s);
+}
+
+int main() {
+    const auto timeout = chrono::milliseconds(50);
+    EventLoop loop;
+
+    // 1. One theater, step by step.
+    {
+        cout << "=== Async Facade: single theater ===\n";
+        Theater theater(loop, 7, 0.0, timeout);
+        theater.setVerbose(true);
+        Stats stats;
+        movieNight(theater, "Inception", CancelToken(loop), stats);
+        loop.run();
+        cout << "Result: " << (stats.ok ? "Ok" : "failed") << "\n";
+    }
+
+    // 2. Thousands of in-flight sequences on this one thread. 1% of DVD
+    //    commands hang (-> Timeout) and every 10th theater is cancelled.
+    {
+        const int kTheaters = 5000;
+        cout << "\n=== Async Facade: " << kTheaters << " theaters, 1 thread ===\n";
+
+        vector<unique_ptr<Theater>> theaters;
+        vector<CancelToken> tokens;
+        theaters.reserve(kTheaters);
+        Stats stats;
+
+        auto start = Clock::now();
+        for (int i = 0; i < kTheaters; i++) {
+            theaters.push_back(make_unique<Theater>(loop, 100 + i * 3, 0.01, timeout));
+            tokens.emplace_back(loop);
+            movieNight(*theaters.back(), "Movie #" + to_string(i), tokens.back(), stats);
+        }
+        for (int i = 0; i < kTheaters; i += 10) tokens[i].cancel();
+        loop.run();
+        auto elapsed = chrono::duration_cast<chrono::milliseconds>(Clock::now() - start);
+
+        cout << "Ok: " << stats.ok << ", Timeout: " << stats.timeout
+             << ", Cancelled: " << stats.cancelled << "\n";
+        cout << "Wall time: " << elapsed.count() << " ms\n";
+    }
+
+    return 0;
+}
+
+/* ==========================================================
+   SAMPLE OUTPUT (timings and counts vary)
+   ----------------------------------------------------------
+   === Async Facade: single theater ===
+     -> PopcornMaker on
+     -> PopcornMaker pop
+     -> Lights dim 10%
+     -> Screen down
+     -> Projector on
+     -> Projector setInput DVD
+     -> Amplifier on
+     -> Amplifier setSource DVD
+     -> Amplifier setVolume 5
+     -> DVDPlayer on
+     -> DVDPlayer play Inception
+     -> PopcornMaker off
+     -> Lights on
+     -> Screen up
+     -> Projector off
+     -> Amplifier off
+     -> DVDPlayer stop
+     -> DVDPlayer off
+   Result: Ok
+
+   === Async Facade: 5000 theaters, 1 thread ===
+   Ok: 4325, Timeout: 175, Cancelled: 500
+   Wall time: 408 ms
+   ========================================================== */
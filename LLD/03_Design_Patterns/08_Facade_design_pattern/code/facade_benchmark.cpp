@@ -0,0 +1,214 @@
+#include <string>
+#include "../../common/pattern_bench.h"
+using namespace std;
+
+/* ==========================================================
+   FACADE - without vs with, measured
+   ----------------------------------------------------------
+   Same subsystem and facade as without_facade.cpp and
+   with_facade.cpp. Each device now records its state and counts
+   its calls instead of printing, so we measure the calls and not
+   cout.
+
+   Measured per movie night (watchMovie + endMovie, 18 device calls):
+   - without/movieNight : the client calls every device itself
+   - with/movieNight    : the client calls the HomeTheaterFacade
+   - with/movieNight/outOfLine : same, but the facade's methods
+                          are real calls, like a facade living
+                          in another library
+
+   Build: g++ -std=c++20 -O2 facade_benchmark.cpp
+   Run  : ./a.out > facade.json
+   ========================================================== */
+
+// --- Subsystem: state + call counters instead of cout ---
+class DVDPlayer {
+public:
+    bool isOn = false, playing = false;
+    size_t titleLength = 0;
+    uint64_t calls = 0;
+    void on() { isOn = true; calls++; }
+    void play(const string& movie) { playing = true; titleLength = movie.size(); calls++; }
+    void stop() { playing = false; calls++; }
+    void off() { isOn = false; calls++; }
+};
+
+class Projector {
+public:
+    bool isOn = false;
+    DVDPlayer* input = nullptr;
+    uint64_t calls = 0;
+    void on() { isOn = true; calls++; }
+    void setInput(DVDPlayer* dvd) { input = dvd; calls++; }
+    void off() { isOn = false; calls++; }
+};
+
+class Amplifier {
+public:
+    bool isOn = false;
+    DVDPlayer* source = nullptr;
+    int volume = 0;
+    uint64_t calls = 0;
+    void on() { isOn = true; calls++; }
+    void setSource(DVDPlayer* dvd) { source = dvd; calls++; }
+    void setVolume(int level) { volume = level; calls++; }
+    void off() { isOn = false; calls++; }
+};
+
+class Lights {
+public:
+    int level = 100;
+    uint64_t calls = 0;
+    void dim(int l) { level = l; calls++; }
+    void on() { level = 100; calls++; }
+};
+
+class Screen {
+public:
+    bool isDown = false;
+    uint64_t calls = 0;
+    void down() { isDown = true; calls++; }
+    void up() { isDown = false; calls++; }
+};
+
+class PopcornMaker {
+public:
+    bool isOn = false;
+    uint64_t popped = 0, calls = 0;
+    void on() { isOn = true; calls++; }
+    void pop() { popped++; calls++; }
+    void off() { isOn = false; calls++; }
+};
+
+// --- Facade (NoInline = false is with_facade.cpp as written) ---
+template <bool NoInline>
+class HomeTheaterFacade {
+private:
+    DVDPlayer* dvd;
+    Projector* projector;
+    Amplifier* amp;
+    Lights* lights;
+    Screen* screen;
+    PopcornMaker* popcorn;
+
+public:
+    HomeTheaterFacade(DVDPlayer* d, Projector* p, Amplifier* a,
+                      Lights* l, Screen* s, PopcornMaker* pm)
+        : dvd(d), projector(p), amp(a), lights(l), screen(s), popcorn(pm) {}
+
+    [[gnu::noinline]] void watchMovieOutOfLine(const string& movie) { watchMovieInline(movie); }
+    [[gnu::noinline]] void endMovieOutOfLine() { endMovieInline(); }
+
+    void watchMovie(const string& movie) {
+        if constexpr (NoInline) watchMovieOutOfLine(movie);
+        else watchMovieInline(movie);
+    }
+    void endMovie() {
+        if constexpr (NoInline) endMovieOutOfLine();
+        else endMovieInline();
+    }
+
+private:
+    void watchMovieInline(const string& movie) {
+        popcorn->on();
+        popcorn->pop();
+        lights->dim(10);
+        screen->down();
+        projector->on();
+        projector->setInput(dvd);
+        amp->on();
+        amp->setSource(dvd);
+        amp->setVolume(5);
+        dvd->on();
+        dvd->play(movie);
+    }
+
+    void endMovieInline() {
+        popcorn->off();
+        lights->on();
+        screen->up();
+        projector->off();
+        amp->off();
+        dvd->stop();
+        dvd->off();
+    }
+};
+
+struct Theater {
+    DVDPlayer dvd;
+    Projector projector;
+    Amplifier amp;
+    Lights lights;
+    Screen screen;
+    PopcornMaker popcorn;
+
+    uint64_t calls() const {
+        return dvd.calls + projector.calls + amp.calls + lights.calls + screen.calls + popcorn.calls;
+    }
+};
+
+int main() {
+    const uint64_t N = 10000000;
+    PatternBench bench("facade");
+    const string movie = "Inception";
+
+    Theater a;
+    bench.run("without/movieNight", N, [&] {
+        doNotOptimize(a);
+        a.popcorn.on();
+        a.popcorn.pop();
+        a.lights.dim(10);
+        a.screen.down();
+        a.projector.on();
+        a.projector.setInput(&a.dvd);
+        a.amp.on();
+        a.amp.setSource(&a.dvd);
+        a.amp.setVolume(5);
+        a.dvd.on();
+        a.dvd.play(movie);
+
+        a.popcorn.off();
+        a.lights.on();
+        a.screen.up();
+        a.projector.off();
+        a.amp.off();
+        a.dvd.stop();
+        a.dvd.off();
+    });
+
+    Theater b;
+    HomeTheaterFacade<false> facade(&b.dvd, &b.projector, &b.amp, &b.lights, &b.screen, &b.popcorn);
+    bench.run("with/movieNight", N, [&] {
+        doNotOptimize(b);
+        facade.watchMovie(movie);
+        facade.endMovie();
+    });
+
+    Theater c;
+    HomeTheaterFacade<true> remoteFacade(&c.dvd, &c.projector, &c.amp, &c.lights, &c.screen, &c.popcorn);
+    bench.run("with/movieNight/outOfLine", N, [&] {
+        doNotOptimize(c);
+        remoteFacade.watchMovie(movie);
+        remoteFacade.endMovie();
+    });
+
+    bench.report();
+    fprintf(stderr, "(device calls: %llu / %llu / %llu)\n", (unsigned long long)a.calls(),
+            (unsigned long long)b.calls(), (unsigned long long)c.calls());
+    return 0;
+}
+
+/* ==========================================================
+   SAMPLE OUTPUT (stderr; numbers depend on the machine)
+   ----------------------------------------------------------
+   === facade ===
+   without/movieNight                   5.53 ns/op    0.00 allocs/op      0.0 B/op      n/a instr/op
+   with/movieNight                      6.04 ns/op    0.00 allocs/op      0.0 B/op      n/a instr/op
+   with/movieNight/outOfLine           13.83 ns/op    0.00 allocs/op      0.0 B/op      n/a instr/op
+
+   Takeaways:
+   - A facade the compiler can see is free: it inlines into the
+     same 18 device calls the client would have written.
+   - Out of line it costs two calls plus reloading the six device
+     pointers: a few ns per movie night, no allocations.
+   ========================================================== */
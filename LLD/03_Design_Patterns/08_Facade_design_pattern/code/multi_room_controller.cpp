@@ -0,0 +1,339 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+using namespace std;
+
+/* ==========================================================
+   MULTI-ROOM FACADE CONTROLLER
+   ----------------------------------------------------------
+   One HomeTheaterFacade (and effectively one thread) per room
+   grows linearly with the venue. Here a single controller owns
+   N small room facades and a FIXED pool of worker threads.
+
+   - Scene requests are collected and applied once per tick.
+     Several requests for the same room in one tick collapse
+     into the latest one.
+   - A room's scene becomes a short list of device ops. Workers
+     take a room from a shared round-robin queue, run at most
+     `quantum` ops, and put it back at the end. No room can
+     starve the others.
+   - Latency (request() call -> last device op done) is tracked
+     per room. With collapsed requests it is measured from the
+     first one: that is how long the room has been waiting.
+
+   Memory per room is a few dozen bytes; threads stay fixed.
+
+   Limit: a worker is blocked for the whole of each device op, so
+   this fits devices that answer in microseconds (a local bus).
+   With millisecond round-trips (as in async_facade.cpp) 10k
+   rooms x 11 ops on 4 workers would take tens of seconds per
+   tick; there the waits have to overlap, e.g. by running each
+   room's ops as coroutines on that file's event loop.
+   ========================================================== */
+
+using Clock = chrono::steady_clock;
+
+// --- Device operations (one per subsystem call in with_facade.cpp) ---
+enum Op : uint8_t {
+    PopcornOn, PopcornPop, PopcornOff,
+    LightsDim, LightsOn,
+    ScreenDown, ScreenUp,
+    ProjectorOn, ProjectorInput, ProjectorOff,
+    AmpOn, AmpSource, AmpVolume, AmpOff,
+    DvdOn, DvdPlay, DvdStop, DvdOff
+};
+
+enum class SceneKind : uint8_t { None, WatchMovie, EndMovie };
+
+struct SceneRequest {
+    int room;
+    SceneKind kind;
+    Clock::time_point at;
+};
+
+// Stands in for the round-trip to a real device. The worker sleeps
+// like it would on blocking I/O, so it holds no CPU but is not free
+// for other rooms either (see the limit above).
+void simulateDeviceCall(chrono::nanoseconds cost) {
+    this_thread::sleep_for(cost);
+}
+
+// --- Room Facade ---
+// Same sequences as HomeTheaterFacade, but recorded as a list of ops
+// so a worker can run them a few at a time.
+class RoomFacade {
+private:
+    static const int MAX_OPS = 12;
+    Op plan[MAX_OPS];
+    uint8_t planSize = 0;
+    uint8_t next = 0;
+
+    // Known device state, one bit per device being on
+    uint8_t poweredMask = 0;
+
+    void push(Op op) { plan[planSize++] = op; }
+
+public:
+    Clock::time_point requestedAt;
+
+    void watchMovie() {
+        planSize = next = 0;
+        push(PopcornOn); push(PopcornPop); push(LightsDim); push(ScreenDown);
+        push(ProjectorOn); push(ProjectorInput);
+        push(AmpOn); push(AmpSource); push(AmpVolume);
+        push(DvdOn); push(DvdPlay);
+    }
+
+    void endMovie() {
+        planSize = next = 0;
+        push(PopcornOff); push(LightsOn); push(ScreenUp); push(ProjectorOff);
+        push(AmpOff); push(DvdStop); push(DvdOff);
+    }
+
+    bool hasWork() const { return next < planSize; }
+
+    // Runs up to `quantum` ops; returns true when the scene is complete.
+    bool runSome(int quantum, chrono::nanoseconds opCost) {
+        for (int i = 0; i < quantum && hasWork(); i++) {
+            Op op = plan[next++];
+            simulateDeviceCall(opCost);
+            switch (op) {
+                case PopcornOn: poweredMask |= 1; break;
+                case PopcornOff: poweredMask &= ~1; break;
+                case ProjectorOn: poweredMask |= 2; break;
+                case ProjectorOff: poweredMask &= ~2; break;
+                case AmpOn: poweredMask |= 4; break;
+                case AmpOff: poweredMask &= ~4; break;
+                case DvdOn: poweredMask |= 8; break;
+                case DvdOff: poweredMask &= ~8; break;
+                default: break;
+            }
+        }
+        return !hasWork();
+    }
+
+    bool allOn() const { return poweredMask == 15; }
+};
+
+// Per-room latency, in microseconds.
+struct RoomStats {
+    uint32_t scenes = 0;
+    uint32_t lastUs = 0;
+    uint32_t maxUs = 0;
+    uint64_t totalUs = 0;
+};
+
+struct TickReport {
+    int scenes = 0;
+    int coalesced = 0;
+    long wallUs = 0;
+    uint32_t p50Us = 0, p99Us = 0, maxUs = 0;
+};
+
+// --- Controller ---
+class MultiRoomController {
+private:
+    vector<RoomFacade> rooms;
+    vector<RoomStats> stats;
+    int quantum;
+    chrono::nanoseconds opCost;
+
+    // Requests submitted since the last tick
+    mutex requestMtx;
+    vector<SceneRequest> incoming;
+
+    // Per-tick scratch, kept across ticks so a tick does not allocate.
+    // latest[r].kind is None again after every tick.
+    vector<SceneRequest> batch;
+    vector<SceneRequest> latest;
+    vector<int> touched;
+    vector<uint32_t> lat;
+
+    // Round-robin queue of rooms that still have ops to run
+    mutex queueMtx;
+    condition_variable workAvailable;
+    condition_variable tickDone;
+    deque<int> runQueue;
+    int roomsInFlight = 0;
+    bool stopping = false;
+
+    vector<thread> workers;
+
+    void workerLoop() {
+        unique_lock<mutex> lock(queueMtx);
+        while (true) {
+            workAvailable.wait(lock, [&] { return stopping || !runQueue.empty(); });
+            if (stopping) return;
+
+            int r = runQueue.front();
+            runQueue.pop_front();
+            lock.unlock();
+
+            bool finished = rooms[r].runSome(quantum, opCost);
+            if (finished) {
+                auto us = chrono::duration_cast<chrono::microseconds>(
+                    Clock::now() - rooms[r].requestedAt).count();
+                RoomStats& s = stats[r];
+                s.scenes++;
+                s.lastUs = (uint32_t)us;
+                s.maxUs = max(s.maxUs, (uint32_t)us);
+                s.totalUs += us;
+            }
+
+            lock.lock();
+            if (finished) {
+                if (--roomsInFlight == 0) tickDone.notify_all();
+            } else {
+                runQueue.push_back(r);  // back of the line: fairness between rooms
+            }
+        }
+    }
+
+public:
+    MultiRoomController(int roomCount, int threadCount, int opsPerTurn, chrono::nanoseconds deviceCost)
+        : rooms(roomCount), stats(roomCount), quantum(opsPerTurn), opCost(deviceCost),
+          latest(roomCount, SceneRequest{0, SceneKind::None, {}}) {
+        for (int i = 0; i < threadCount; i++) workers.emplace_back(&MultiRoomController::workerLoop, this);
+    }
+
+    ~MultiRoomController() {
+        {
+            lock_guard<mutex> lock(queueMtx);
+            stopping = true;
+        }
+        workAvailable.notify_all();
+        for (thread& t : workers) t.join();
+    }
+
+    // Thread-safe; applied on the next tick(). Latency is measured from here.
+    void request(int room, SceneKind kind) {
+        if (room < 0 || room >= (int)rooms.size()) throw out_of_range("no such room");
+        if (kind == SceneKind::None) throw invalid_argument("no scene requested");
+        auto now = Clock::now();
+        lock_guard<mutex> lock(requestMtx);
+        incoming.push_back({room, kind, now});
+    }
+
+    // Applies every request received since the last tick and waits until
+    // all affected rooms have finished their device ops.
+    TickReport tick() {
+        TickReport report;
+        auto start = Clock::now();
+
+        batch.clear();
+        {
+            lock_guard<mutex> lock(requestMtx);
+            batch.swap(incoming);
+        }
+
+        // Latest request per room wins; the wait counts from the first one
+        touched.clear();
+        for (const SceneRequest& req : batch) {
+            SceneRequest& slot = latest[req.room];
+            if (slot.kind == SceneKind::None) {
+                slot = req;
+                touched.push_back(req.room);
+            } else {
+                report.coalesced++;
+                slot.kind = req.kind;
+            }
+        }
+
+        for (int r : touched) {
+            rooms[r].requestedAt = latest[r].at;
+            if (latest[r].kind == SceneKind::WatchMovie) rooms[r].watchMovie();
+            else rooms[r].endMovie();
+            latest[r].kind = SceneKind::None;
+        }
+        report.scenes = (int)touched.size();
+
+        {
+            unique_lock<mutex> lock(queueMtx);
+            roomsInFlight = (int)touched.size();
+            runQueue.assign(touched.begin(), touched.end());
+            workAvailable.notify_all();
+            tickDone.wait(lock, [&] { return roomsInFlight == 0; });
+        }
+
+        report.wallUs = chrono::duration_cast<chrono::microseconds>(Clock::now() - start).count();
+
+        lat.clear();
+        for (int r : touched) lat.push_back(stats[r].lastUs);
+        if (!lat.empty()) {
+            sort(lat.begin(), lat.end());
+            report.p50Us = lat[lat.size() / 2];
+            report.p99Us = lat[lat.size() * 99 / 100];
+            report.maxUs = lat.back();
+        }
+        return report;
+    }
+
+    const RoomStats& roomStats(int room) const { return stats[room]; }
+    const RoomFacade& room(int r) const { return rooms[r]; }
+    int roomCount() const { return (int)rooms.size(); }
+};
+
+// --- Client code ---
+int main() {
+    const int kRooms = 10000;
+    const int kThreads = 4;
+    const int kQuantum = 2;
+    const auto kDeviceCost = chrono::nanoseconds(1000);
+
+    cout << "=== Multi-Room Controller: " << kRooms << " rooms, "
+         << kThreads << " worker threads ===\n";
+    cout << "Memory per room: " << sizeof(RoomFacade) + sizeof(RoomStats) << " bytes\n\n";
+
+    MultiRoomController controller(kRooms, kThreads, kQuantum, kDeviceCost);
+
+    auto print = [](const string& label, const TickReport& t) {
+        cout << label << ": scenes=" << t.scenes << " coalesced=" << t.coalesced
+             << " wall=" << t.wallUs / 1000 << "ms"
+             << " room latency p50=" << t.p50Us / 1000 << "ms"
+             << " p99=" << t.p99Us / 1000 << "ms"
+             << " max=" << t.maxUs / 1000 << "ms\n";
+    };
+
+    // Tick 1: every room starts a movie; every 100th room asks twice.
+    for (int r = 0; r < kRooms; r++) controller.request(r, SceneKind::WatchMovie);
+    for (int r = 0; r < kRooms; r += 100) controller.request(r, SceneKind::WatchMovie);
+    print("Tick 1 (watch)", controller.tick());
+
+    int allOn = 0;
+    for (int r = 0; r < kRooms; r++) allOn += controller.room(r).allOn();
+    cout << "Rooms with every device on: " << allOn << "\n";
+
+    // Tick 2: half of the venue ends its movie.
+    for (int r = 0; r < kRooms; r += 2) controller.request(r, SceneKind::EndMovie);
+    print("Tick 2 (end) ", controller.tick());
+
+    const RoomStats& s = controller.roomStats(0);
+    cout << "Room 0: scenes=" << s.scenes << " avg=" << s.totalUs / s.scenes / 1000
+         << "ms max=" << s.maxUs / 1000 << "ms\n";
+
+    return 0;
+}
+
+/* ==========================================================
+   SAMPLE OUTPUT (timings depend on the machine)
+   ----------------------------------------------------------
+   === Multi-Room Controller: 10000 rooms, 4 worker threads ===
+   Memory per room: 48 bytes
+
+   Tick 1 (watch): scenes=10000 coalesced=100 wall=1587ms room latency p50=1517ms p99=1585ms max=1587ms
+   Rooms with every device on: 10000
+   Tick 2 (end) : scenes=5000 coalesced=0 wall=511ms room latency p50=476ms p99=510ms max=511ms
+   Room 0: scenes=2 avg=944ms max=1448ms
+
+   A 1 us sleep lasts ~55 us on Linux (timer slack), so each op
+   costs about that. The whole run uses ~0.1 s of CPU: latency
+   here is time spent waiting in the run queue, not CPU contention.
+   ========================================================== */
@@ -0,0 +1,291 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <optional>
+#include <functional>
+using namespace std;
+
+/* ==========================================================
+   SCENE-DIFFING FACADE
+   ----------------------------------------------------------
+   with_facade.cpp re-runs every on()/dim()/down()/setVolume()
+   on each watchMovie(), even if the theater is already set up.
+   Every call is a device round-trip.
+
+   Here the facade remembers what it knows about each device.
+   "Watch movie" and "end movie" are target Scenes, and switching
+   scenes issues only the transitions that differ from the known
+   state. Unknown state (std::nullopt) is always re-sent.
+   ========================================================== */
+
+// --- Subsystem Classes (same as with_facade.cpp) ---
+
+class DVDPlayer {
+public:
+    void on() { cout << "DVD Player ON\n"; }
+    void play(const string& movie) { cout << "Playing movie: " << movie << "\n"; }
+    void stop() { cout << "Stopping DVD\n"; }
+    void off() { cout << "DVD Player OFF\n"; }
+};
+
+class Projector {
+public:
+    void on() { cout << "Projector ON\n"; }
+    void setInput(DVDPlayer*) { cout << "Projector set to DVD input\n"; }
+    void off() { cout << "Projector OFF\n"; }
+};
+
+class Amplifier {
+public:
+    void on() { cout << "Amplifier ON\n"; }
+    void setSource(DVDPlayer*) { cout << "Amplifier source set to DVD\n"; }
+    void setVolume(int level) { cout << "Volume set to " << level << "\n"; }
+    void off() { cout << "Amplifier OFF\n"; }
+};
+
+class Lights {
+public:
+    void dim(int level) { cout << "Lights dimmed to " << level << "%\n"; }
+    void on() { cout << "Lights ON\n"; }
+};
+
+class Screen {
+public:
+    void down() { cout << "Screen going down\n"; }
+    void up() { cout << "Screen going up\n"; }
+};
+
+class PopcornMaker {
+public:
+    void on() { cout << "Popcorn Maker ON\n"; }
+    void pop() { cout << "Popping popcorn...\n"; }
+    void off() { cout << "Popcorn Maker OFF\n"; }
+};
+
+// --- Scenes and known state ---
+
+const int LIGHTS_FULL = 100;
+
+// What the theater should look like.
+struct Scene {
+    string name;
+    bool popcornOn;
+    int lightLevel;     // LIGHTS_FULL means lights->on()
+    bool screenDown;
+    bool projectorOn;
+    bool ampOn;
+    int volume;         // only applied while the amp is on
+    bool dvdOn;
+    string movie;       // empty = nothing playing
+};
+
+// What the facade believes the devices look like. nullopt = unknown.
+// Powering a device off forgets its settings (input, source, volume).
+struct TheaterState {
+    optional<bool> popcornOn;
+    optional<bool> popped;
+    optional<int> lightLevel;
+    optional<bool> screenDown;
+    optional<bool> projectorOn;
+    optional<bool> projectorOnDvd;
+    optional<bool> ampOn;
+    optional<bool> ampOnDvd;
+    optional<int> volume;
+    optional<bool> dvdOn;
+    optional<string> playing;
+};
+
+// One device call.
+using Transition = function<void()>;
+
+// --- Facade Class ---
+
+class SceneHomeTheaterFacade {
+private:
+    DVDPlayer* dvd;
+    Projector* projector;
+    Amplifier* amp;
+    Lights* lights;
+    Screen* screen;
+    PopcornMaker* popcorn;
+
+    TheaterState state;
+    int roundTrips = 0;
+
+    // Walks the devices in the same order as with_facade.cpp and records
+    // only the calls needed to get from `s` to `target`. Updates `s`.
+    vector<Transition> plan(TheaterState& s, const Scene& target) const {
+        vector<Transition> steps;
+        auto add = [&](Transition fn) { steps.push_back(move(fn)); };
+
+        // Popcorn
+        if (target.popcornOn) {
+            if (s.popcornOn != true) { add([this] { popcorn->on(); }); s.popcornOn = true; }
+            if (s.popped != true) { add([this] { popcorn->pop(); }); s.popped = true; }
+        } else if (s.popcornOn != false) {
+            add([this] { popcorn->off(); });
+            s.popcornOn = false;
+            s.popped = false;
+        }
+
+        // Lights
+        if (s.lightLevel != target.lightLevel) {
+            int level = target.lightLevel;
+            if (level == LIGHTS_FULL) add([this] { lights->on(); });
+            else add([this, level] { lights->dim(level); });
+            s.lightLevel = level;
+        }
+
+        // Screen
+        if (s.screenDown != target.screenDown) {
+            if (target.screenDown) add([this] { screen->down(); });
+            else add([this] { screen->up(); });
+            s.screenDown = target.screenDown;
+        }
+
+        // Projector
+        if (target.projectorOn) {
+            if (s.projectorOn != true) { add([this] { projector->on(); }); s.projectorOn = true; }
+            if (s.projectorOnDvd != true) {
+                add([this] { projector->setInput(dvd); });
+                s.projectorOnDvd = true;
+            }
+        } else if (s.projectorOn != false) {
+            add([this] { projector->off(); });
+            s.projectorOn = false;
+            s.projectorOnDvd.reset();
+        }
+
+        // Amplifier
+        if (target.ampOn) {
+            if (s.ampOn != true) { add([this] { amp->on(); }); s.ampOn = true; }
+            if (s.ampOnDvd != true) { add([this] { amp->setSource(dvd); }); s.ampOnDvd = true; }
+            if (s.volume != target.volume) {
+                int level = target.volume;
+                add([this, level] { amp->setVolume(level); });
+                s.volume = level;
+            }
+        } else if (s.ampOn != false) {
+            add([this] { amp->off(); });
+            s.ampOn = false;
+            s.ampOnDvd.reset();
+            s.volume.reset();
+        }
+
+        // DVD Player
+        if (target.dvdOn) {
+            if (s.dvdOn != true) { add([this] { dvd->on(); }); s.dvdOn = true; s.playing = ""; }
+            if (s.playing != target.movie) {
+                if (s.playing != "") { add([this] { dvd->stop(); }); }
+                string movie = target.movie;
+                if (!movie.empty()) add([this, movie] { dvd->play(movie); });
+                s.playing = movie;
+            }
+        } else if (s.dvdOn != false) {
+            if (s.playing != "") add([this] { dvd->stop(); });
+            add([this] { dvd->off(); });
+            s.dvdOn = false;
+            s.playing = "";
+        }
+
+        return steps;
+    }
+
+public:
+    SceneHomeTheaterFacade(DVDPlayer* d, Projector* p, Amplifier* a,
+                           Lights* l, Screen* s, PopcornMaker* pm)
+        : dvd(d), projector(p), amp(a), lights(l), screen(s), popcorn(pm) {}
+
+    static Scene movieScene(const string& movie) {
+        return {"Watch " + movie, true, 10, true, true, true, 5, true, movie};
+    }
+
+    static Scene idleScene() {
+        return {"End movie", false, LIGHTS_FULL, false, false, false, 0, false, ""};
+    }
+
+    // Returns the number of device calls that were issued.
+    int applyScene(const Scene& target) {
+        TheaterState next = state;
+        vector<Transition> steps = plan(next, target);
+
+        cout << "\n[" << target.name << "] " << steps.size() << " transition(s)\n";
+        for (Transition& t : steps) t();
+
+        state = next;
+        roundTrips += (int)steps.size();
+        return (int)steps.size();
+    }
+
+    void watchMovie(const string& movie) { applyScene(movieScene(movie)); }
+    void endMovie() { applyScene(idleScene()); }
+
+    // Call when devices may have been changed behind the facade's back
+    // (e.g. someone used the physical remote). Next scene re-sends everything.
+    void forgetState() { state = TheaterState{}; }
+
+    int totalRoundTrips() const { return roundTrips; }
+};
+
+// --- Client code ---
+int main() {
+    cout << "=== Scene-Diffing Facade ===\n";
+
+    DVDPlayer dvd;
+    Projector projector;
+    Amplifier amp;
+    Lights lights;
+    Screen screen;
+    PopcornMaker popcorn;
+
+    SceneHomeTheaterFacade homeTheater(&dvd, &projector, &amp, &lights, &screen, &popcorn);
+
+    homeTheater.watchMovie("Inception");     // state unknown: full sequence
+    homeTheater.watchMovie("Inception");     // already there: nothing to do
+    homeTheater.watchMovie("Interstellar");  // only the DVD changes
+    homeTheater.endMovie();
+    homeTheater.endMovie();                  // already off: nothing to do
+
+    cout << "\nTotal device round-trips: " << homeTheater.totalRoundTrips()
+         << " (with_facade.cpp would issue " << 3 * 11 + 2 * 7 << ")\n";
+
+    return 0;
+}
+
+/* ==========================================================
+   SAMPLE OUTPUT
+   ----------------------------------------------------------
+   === Scene-Diffing Facade ===
+
+   [Watch Inception] 11 transition(s)
+   Popcorn Maker ON
+   Popping popcorn...
+   Lights dimmed to 10%
+   Screen going down
+   Projector ON
+   Projector set to DVD input
+   Amplifier ON
+   Amplifier source set to DVD
+   Volume set to 5
+   DVD Player ON
+   Playing movie: Inception
+
+   [Watch Inception] 0 transition(s)
+
+   [Watch Interstellar] 2 transition(s)
+   Stopping DVD
+   Playing movie: Interstellar
+
+   [End movie] 7 transition(s)
+   Popcorn Maker OFF
+   Lights ON
+   Screen going up
+   Projector OFF
+   Amplifier OFF
+   Stopping DVD
+   DVD Player OFF
+
+   [End movie] 0 transition(s)
+
+   Total device round-trips: 20 (with_facade.cpp would issue 47)
+   ========================================================== */
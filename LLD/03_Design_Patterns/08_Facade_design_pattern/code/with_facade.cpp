@@ -1,49 +1,52 @@
 #include <iostream>
 #include <string>
+#include "../../common/instrumentation.h"
 using namespace std;
 
+// Build: g++ -std=c++20 with_facade.cpp   (-DINSTRUMENTATION_OFF compiles the metrics out)
+
 // --- Subsystem Classes ---
 
 class DVDPlayer {
 public:
-    void on() { cout << "DVD Player ON\n"; }
-    void play(const string& movie) { cout << "Playing movie: " << movie << endl; }
-    void stop() { cout << "Stopping DVD\n"; }
-    void off() { cout << "DVD Player OFF\n"; }
+    void on() { EVENT_LOG("DVD Player ON"); }
+    void play(const string& movie) { EVENT_LOG("Playing movie: " << movie); }
+    void stop() { EVENT_LOG("Stopping DVD"); }
+    void off() { EVENT_LOG("DVD Player OFF"); }
 };
 
 class Projector {
 public:
-    void on() { cout << "Projector ON\n"; }
-    void setInput(DVDPlayer* dvd) { cout << "Projector set to DVD input\n"; }
-    void off() { cout << "Projector OFF\n"; }
+    void on() { EVENT_LOG("Projector ON"); }
+    void setInput(DVDPlayer* dvd) { EVENT_LOG("Projector set to DVD input"); }
+    void off() { EVENT_LOG("Projector OFF"); }
 };
 
 class Amplifier {
 public:
-    void on() { cout << "Amplifier ON\n"; }
-    void setSource(DVDPlayer* dvd) { cout << "Amplifier source set to DVD\n"; }
-    void setVolume(int level) { cout << "Volume set to " << level << endl; }
-    void off() { cout << "Amplifier OFF\n"; }
+    void on() { EVENT_LOG("Amplifier ON"); }
+    void setSource(DVDPlayer* dvd) { EVENT_LOG("Amplifier source set to DVD"); }
+    void setVolume(int level) { EVENT_LOG("Volume set to " << level); }
+    void off() { EVENT_LOG("Amplifier OFF"); }
 };
 
 class Lights {
 public:
-    void dim(int level) { cout << "Lights dimmed to " << level << "%\n"; }
-    void on() { cout << "Lights ON\n"; }
+    void dim(int level) { EVENT_LOG("Lights dimmed to " << level << "%"); }
+    void on() { EVENT_LOG("Lights ON"); }
 };
 
 class Screen {
 public:
-    void down() { cout << "Screen going down\n"; }
-    void up() { cout << "Screen going up\n"; }
+    void down() { EVENT_LOG("Screen going down"); }
+    void up() { EVENT_LOG("Screen going up"); }
 };
 
 class PopcornMaker {
 public:
-    void on() { cout << "Popcorn Maker ON\n"; }
-    void pop() { cout << "Popping popcorn...\n"; }
-    void off() { cout << "Popcorn Maker OFF\n"; }
+    void on() { EVENT_LOG("Popcorn Maker ON"); }
+    void pop() { COUNT_EVENT("popcorn.popped"); EVENT_LOG("Popping popcorn..."); }
+    void off() { EVENT_LOG("Popcorn Maker OFF"); }
 };
 
 // --- Facade Class ---
@@ -63,7 +66,8 @@ public:
         : dvd(d), projector(p), amp(a), lights(l), screen(s), popcorn(pm) {}
 
     void watchMovie(const string& movie) {
-        cout << "\nGet ready to watch a movie...\n";
+        TIME_SCOPE("theater.watchMovie");
+        EVENT_LOG("\nGet ready to watch a movie...");
         popcorn->on();
         popcorn->pop();
         lights->dim(10);
@@ -78,7 +82,8 @@ public:
     }
 
     void endMovie() {
-        cout << "\nShutting movie theater down...\n";
+        TIME_SCOPE("theater.endMovie");
+        EVENT_LOG("\nShutting movie theater down...");
         popcorn->off();
         lights->on();
         screen->up();
@@ -91,6 +96,7 @@ public:
 
 // --- Client code with Facade ---
 int main() {
+    MetricsRegistry::instance().addConsoleSink();
     cout << "=== With Facade ===\n\n";
 
     DVDPlayer dvd;
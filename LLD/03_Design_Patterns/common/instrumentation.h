@@ -0,0 +1,478 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* ==========================================================
+   INSTRUMENTATION - counters and timers instead of cout
+   ----------------------------------------------------------
+   The examples used to report every event with
+   `cout << ... << endl`. endl flushes, so on a hot path the
+   printing was most of the work. Hot paths now report through
+   three macros:
+
+   - COUNT_EVENT("name")      : +1 on a per-thread counter
+   - TIME_SCOPE("name")       : time of the enclosing scope goes
+                                into a latency histogram
+   - EVENT_LOG(a << b << ...) : one human-readable line; it is
+                                only formatted when a text sink
+                                is attached
+
+   Each thread writes its own counters and histograms (no locks,
+   no shared cache lines); readers add them up. When a thread
+   exits, its numbers are folded into one "retired" total and
+   its storage is freed. Nothing is
+   printed unless main() asks for it:
+
+     MetricsRegistry::instance().addConsoleSink();      // the old output
+     MetricsRegistry::instance().addFileSink("run.log");
+     MetricsExporter exporter("metrics.jsonl", 1000ms);  // snapshot every second
+     MetricsRegistry::instance().printSummary(cerr);
+
+   Build with -DINSTRUMENTATION_OFF and the three macros become
+   no-ops: no clock reads, no counters, no strings.
+   ========================================================== */
+
+namespace instrumentation {
+
+// Single-writer add: a plain load + store, no locked instruction.
+// Other threads may read the value at any time.
+inline void bumpCounter(std::atomic<uint64_t>& counter, uint64_t by = 1) {
+    counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+// ---------------- Latency histogram -----------------
+// Log-linear buckets like HdrHistogram: exact below 32, then 32
+// buckets per power of two (about 3% error) up to 2^64 ns. The
+// largest value is kept exactly, next to the buckets.
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 5;
+    static constexpr int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static constexpr int BUCKETS = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+    static int bucketOf(uint64_t value) {
+        if (value < uint64_t(SUB_BUCKETS)) return int(value);
+        int exponent = 63 - __builtin_clzll(value);
+        int sub = int(value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+        return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + sub;
+    }
+
+    static uint64_t lowestValue(int bucket) {
+        if (bucket < SUB_BUCKETS) return uint64_t(bucket);
+        int row = bucket / SUB_BUCKETS;
+        int sub = bucket % SUB_BUCKETS;
+        return uint64_t(SUB_BUCKETS + sub) << (row - 1);
+    }
+
+    static uint64_t highestValue(int bucket) {
+        return bucket + 1 < BUCKETS ? lowestValue(bucket + 1) - 1 : UINT64_MAX;
+    }
+
+    // Upper end of the bucket holding quantile q (0..1) of `total` samples,
+    // capped at the largest value seen.
+    static uint64_t quantile(const std::vector<uint64_t>& counts, uint64_t total, uint64_t maxValue, double q) {
+        if (total == 0) return 0;
+        uint64_t rank = uint64_t(q * double(total - 1));
+        uint64_t seen = 0;
+        for (int b = 0; b < BUCKETS; b++) {
+            seen += counts[b];
+            if (seen > rank) return std::min(highestValue(b), maxValue);
+        }
+        return maxValue;
+    }
+
+    // Owner thread only.
+    void record(uint64_t ns) {
+        bumpCounter(counts[bucketOf(ns)]);
+        bumpCounter(sum, ns);
+        if (ns > maxNs.load(std::memory_order_relaxed)) maxNs.store(ns, std::memory_order_relaxed);
+    }
+
+    // Any thread, with locked instructions. Do not mix with record()
+    // on the same histogram.
+    void recordShared(uint64_t ns) {
+        counts[bucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+        sum.fetch_add(ns, std::memory_order_relaxed);
+        uint64_t seen = maxNs.load(std::memory_order_relaxed);
+        while (ns > seen && !maxNs.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Any thread: adds this histogram into `into` (BUCKETS entries).
+    void addTo(std::vector<uint64_t>& into, uint64_t& sumNs, uint64_t& maxValue) const {
+        for (int b = 0; b < BUCKETS; b++) into[b] += counts[b].load(std::memory_order_relaxed);
+        sumNs += sum.load(std::memory_order_relaxed);
+        maxValue = std::max(maxValue, maxNs.load(std::memory_order_relaxed));
+    }
+
+    // Owner thread only: folds `other` into this histogram.
+    void merge(const LatencyHistogram& other) {
+        for (int b = 0; b < BUCKETS; b++) bumpCounter(counts[b], other.counts[b].load(std::memory_order_relaxed));
+        bumpCounter(sum, other.sum.load(std::memory_order_relaxed));
+        uint64_t otherMax = other.max();
+        if (otherMax > maxNs.load(std::memory_order_relaxed)) maxNs.store(otherMax, std::memory_order_relaxed);
+    }
+
+    // ---- Reading one histogram on its own (any thread) ----
+    uint64_t count() const {
+        uint64_t n = 0;
+        for (const auto& c : counts) n += c.load(std::memory_order_relaxed);
+        return n;
+    }
+
+    uint64_t max() const { return maxNs.load(std::memory_order_relaxed); }
+
+    uint64_t percentile(double q) const {
+        std::vector<uint64_t> all(BUCKETS);
+        uint64_t sumNs = 0, maxValue = 0;
+        addTo(all, sumNs, maxValue);
+        uint64_t total = 0;
+        for (uint64_t c : all) total += c;
+        return quantile(all, total, maxValue, q);
+    }
+
+private:
+    std::atomic<uint64_t> counts[BUCKETS] = {};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> maxNs{0};
+};
+
+}  // namespace instrumentation
+
+// ---------------- Per-thread storage -----------------
+constexpr int MAX_METRICS = 64;
+
+struct ThreadMetrics {
+    std::atomic<uint64_t> counters[MAX_METRICS] = {};
+    std::atomic<instrumentation::LatencyHistogram*> histograms[MAX_METRICS] = {};  // allocated on first use
+
+    ThreadMetrics() = default;
+    ThreadMetrics(const ThreadMetrics&) = delete;
+    ThreadMetrics& operator=(const ThreadMetrics&) = delete;
+    ~ThreadMetrics() {
+        for (auto& h : histograms) delete h.load();
+    }
+
+    // Owner only: the histogram for `id`, created on first use.
+    instrumentation::LatencyHistogram& histogram(int id) {
+        instrumentation::LatencyHistogram* h = histograms[id].load(std::memory_order_relaxed);
+        if (!h) {
+            h = new instrumentation::LatencyHistogram();
+            histograms[id].store(h, std::memory_order_release);
+        }
+        return *h;
+    }
+
+    // Any thread: adds metric `id` into the totals.
+    void addTo(int id, uint64_t& events, std::vector<uint64_t>& counts, uint64_t& sumNs, uint64_t& maxNs) const {
+        events += counters[id].load(std::memory_order_relaxed);
+        if (const instrumentation::LatencyHistogram* h = histograms[id].load(std::memory_order_acquire))
+            h->addTo(counts, sumNs, maxNs);
+    }
+};
+
+// One metric added up over all threads.
+struct MetricSnapshot {
+    std::string name;
+    uint64_t events = 0;   // COUNT_EVENT total
+    uint64_t samples = 0;  // TIME_SCOPE total
+    double meanNs = 0;
+    uint64_t p50Ns = 0, p90Ns = 0, p99Ns = 0;  // bucket upper ends, about 3% high
+    uint64_t maxNs = 0;                        // exact
+};
+
+// ---------------- Registry -----------------
+class MetricsRegistry {
+private:
+    mutable std::mutex mtx;  // names, thread list, retired; never taken on the hot path
+    std::vector<std::string> names;
+    std::vector<std::unique_ptr<ThreadMetrics>> threads;  // live threads only
+    ThreadMetrics retired;                                // sum of the threads that exited; written under mtx
+
+    std::mutex sinkMtx;
+    std::vector<std::function<void(const std::string&)>> sinks;
+    std::atomic<bool> hasSinks{false};
+
+    MetricsRegistry() = default;
+
+    ThreadMetrics* registerThread() {
+        std::lock_guard<std::mutex> lock(mtx);
+        threads.push_back(std::make_unique<ThreadMetrics>());
+        return threads.back().get();
+    }
+
+    // Folds an exiting thread's metrics into `retired` and frees them, so
+    // thread churn does not grow the registry.
+    void retireThread(ThreadMetrics* t) {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (int id = 0; id < MAX_METRICS; id++) {
+            instrumentation::bumpCounter(retired.counters[id], t->counters[id].load(std::memory_order_relaxed));
+            if (const instrumentation::LatencyHistogram* h = t->histograms[id].load(std::memory_order_acquire))
+                retired.histogram(id).merge(*h);
+        }
+        for (size_t i = 0; i < threads.size(); i++) {
+            if (threads[i].get() == t) {
+                threads[i] = std::move(threads.back());
+                threads.pop_back();
+                break;
+            }
+        }
+    }
+
+    // Registers the thread on first use and retires it when the thread exits.
+    struct ThreadHandle {
+        ThreadMetrics* metrics = nullptr;
+        ~ThreadHandle() {
+            if (metrics) instance().retireThread(metrics);
+        }
+    };
+
+    static ThreadMetrics& local() {
+        thread_local ThreadHandle mine;
+        if (!mine.metrics) mine.metrics = instance().registerThread();
+        return *mine.metrics;
+    }
+
+public:
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    static MetricsRegistry& instance() {
+        static MetricsRegistry registry;
+        return registry;
+    }
+
+    // Same name -> same id. The macros call this once per call site.
+    int idFor(const char* name) {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (size_t i = 0; i < names.size(); i++)
+            if (names[i] == name) return int(i);
+        if (names.size() == MAX_METRICS) throw std::length_error("too many metrics");
+        names.push_back(name);
+        return int(names.size() - 1);
+    }
+
+    static void count(int id, uint64_t by = 1) { instrumentation::bumpCounter(local().counters[id], by); }
+
+    static void recordLatency(int id, uint64_t ns) { local().histogram(id).record(ns); }
+
+    // ---- Text sinks (human-readable output) ----
+    void addTextSink(std::function<void(const std::string&)> sink) {
+        std::lock_guard<std::mutex> lock(sinkMtx);
+        sinks.push_back(std::move(sink));
+        hasSinks.store(true, std::memory_order_relaxed);
+    }
+
+    // Same lines the examples used to print, without a flush per line.
+    void addConsoleSink() {
+        addTextSink([](const std::string& line) { std::cout << line << '\n'; });
+    }
+
+    void addFileSink(const std::string& path) {
+        auto file = std::make_shared<std::ofstream>(path, std::ios::app);
+        if (!*file) throw std::runtime_error("cannot open " + path);
+        addTextSink([file](const std::string& line) { *file << line << '\n'; });
+    }
+
+    void clearTextSinks() {
+        std::lock_guard<std::mutex> lock(sinkMtx);
+        sinks.clear();
+        hasSinks.store(false, std::memory_order_relaxed);
+    }
+
+    bool textEnabled() const { return hasSinks.load(std::memory_order_relaxed); }
+
+    // Per-thread stream EVENT_LOG formats into; building a new
+    // ostringstream for every line costs more than the line itself.
+    static std::ostringstream& lineBuffer() {
+        thread_local std::ostringstream line;
+        line.str(std::string());
+        line.clear();
+        return line;
+    }
+
+    void emitText(const std::string& line) {
+        std::lock_guard<std::mutex> lock(sinkMtx);
+        for (auto& sink : sinks) sink(line);
+    }
+
+    // ---- Reading ----
+    std::vector<MetricSnapshot> snapshot() const {
+        std::lock_guard<std::mutex> lock(mtx);
+        std::vector<MetricSnapshot> result;
+        std::vector<uint64_t> counts(instrumentation::LatencyHistogram::BUCKETS);
+
+        for (size_t id = 0; id < names.size(); id++) {
+            MetricSnapshot m;
+            m.name = names[id];
+            std::fill(counts.begin(), counts.end(), 0);
+            uint64_t sumNs = 0;
+            retired.addTo(int(id), m.events, counts, sumNs, m.maxNs);
+            for (const auto& t : threads) t->addTo(int(id), m.events, counts, sumNs, m.maxNs);
+            for (uint64_t c : counts) m.samples += c;
+            if (m.samples) {
+                using instrumentation::LatencyHistogram;
+                m.meanNs = double(sumNs) / m.samples;
+                m.p50Ns = LatencyHistogram::quantile(counts, m.samples, m.maxNs, 0.50);
+                m.p90Ns = LatencyHistogram::quantile(counts, m.samples, m.maxNs, 0.90);
+                m.p99Ns = LatencyHistogram::quantile(counts, m.samples, m.maxNs, 0.99);
+            }
+            result.push_back(m);
+        }
+        return result;
+    }
+
+    // One JSON object on one line.
+    void writeJson(std::ostream& out, double elapsedMs) const {
+        char buf[256];
+        std::snprintf(buf, sizeof buf, "{\"elapsed_ms\": %.0f, \"metrics\": [", elapsedMs);
+        out << buf;
+        std::vector<MetricSnapshot> metrics = snapshot();
+        for (size_t i = 0; i < metrics.size(); i++) {
+            const MetricSnapshot& m = metrics[i];
+            std::snprintf(buf, sizeof buf,
+                          "%s{\"name\": \"%s\", \"events\": %llu, \"samples\": %llu, \"mean_ns\": %.1f, "
+                          "\"p50_ns\": %llu, \"p90_ns\": %llu, \"p99_ns\": %llu, \"max_ns\": %llu}",
+                          i ? ", " : "", m.name.c_str(), (unsigned long long)m.events,
+                          (unsigned long long)m.samples, m.meanNs, (unsigned long long)m.p50Ns,
+                          (unsigned long long)m.p90Ns, (unsigned long long)m.p99Ns, (unsigned long long)m.maxNs);
+            out << buf;
+        }
+        out << "]}\n";
+    }
+
+    void printSummary(std::ostream& out) const {
+        char buf[160];
+        std::snprintf(buf, sizeof buf, "%-28s %10s %10s %9s %9s %9s\n", "metric", "events", "samples", "p50 ns",
+                      "p99 ns", "max ns");
+        out << buf;
+        for (const MetricSnapshot& m : snapshot()) {
+            std::snprintf(buf, sizeof buf, "%-28s %10llu %10llu %9llu %9llu %9llu\n", m.name.c_str(),
+                          (unsigned long long)m.events, (unsigned long long)m.samples,
+                          (unsigned long long)m.p50Ns, (unsigned long long)m.p99Ns, (unsigned long long)m.maxNs);
+            out << buf;
+        }
+    }
+};
+
+// ---------------- Scoped timer -----------------
+class ScopedTimer {
+private:
+    int id;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    explicit ScopedTimer(int metricId) : id(metricId), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        MetricsRegistry::recordLatency(id, uint64_t(ns.count()));
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+
+// ---------------- Periodic exporter -----------------
+// Appends one JSON line (see writeJson) to `path` every `interval`,
+// and a last one when destroyed.
+class MetricsExporter {
+private:
+    std::string path;
+    std::chrono::milliseconds interval;
+    std::chrono::steady_clock::time_point started;
+
+    std::mutex mtx;
+    std::condition_variable wake;
+    bool stopping = false;
+    std::thread worker;
+
+    void exportOnce() {
+        std::ofstream out(path, std::ios::app);
+        double elapsedMs =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+        MetricsRegistry::instance().writeJson(out, elapsedMs);
+    }
+
+    void loop() {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (!wake.wait_for(lock, interval, [this] { return stopping; })) {
+            lock.unlock();
+            exportOnce();
+            lock.lock();
+        }
+    }
+
+public:
+    MetricsExporter(std::string file, std::chrono::milliseconds every)
+        : path(std::move(file)), interval(every), started(std::chrono::steady_clock::now()) {
+        worker = std::thread([this] { loop(); });
+    }
+
+    ~MetricsExporter() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+        exportOnce();
+    }
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+};
+
+// ---------------- Macros used by the examples -----------------
+#define INSTRUMENTATION_CONCAT_(a, b) a##b
+#define INSTRUMENTATION_CONCAT(a, b) INSTRUMENTATION_CONCAT_(a, b)
+
+#ifdef INSTRUMENTATION_OFF
+
+#define COUNT_EVENT(name) ((void)0)
+#define TIME_SCOPE(name) ((void)0)
+// Still type-checks the message (and keeps its arguments "used"), never runs it.
+#define EVENT_LOG(message)                                                        \
+    do {                                                                          \
+        if (false) {                                                              \
+            std::ostringstream line_;                                             \
+            line_ << message;                                                     \
+        }                                                                         \
+    } while (0)
+
+#else
+
+#define COUNT_EVENT(name)                                                         \
+    do {                                                                          \
+        static const int metricId_ = MetricsRegistry::instance().idFor(name);     \
+        MetricsRegistry::count(metricId_);                                        \
+    } while (0)
+
+#define TIME_SCOPE(name)                                                                             \
+    static const int INSTRUMENTATION_CONCAT(timerId_, __LINE__) = MetricsRegistry::instance().idFor(name); \
+    ScopedTimer INSTRUMENTATION_CONCAT(timer_, __LINE__)(INSTRUMENTATION_CONCAT(timerId_, __LINE__))
+
+#define EVENT_LOG(message)                                                        \
+    do {                                                                          \
+        MetricsRegistry& registry_ = MetricsRegistry::instance();                 \
+        if (registry_.textEnabled()) {                                            \
+            std::ostringstream& line_ = MetricsRegistry::lineBuffer();            \
+            line_ << message;                                                     \
+            registry_.emitText(line_.str());                                      \
+        }                                                                         \
+    } while (0)
+
+#endif
@@ -0,0 +1,177 @@
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "pattern_bench.h"
+#include "instrumentation.h"
+using namespace std;
+
+/* ==========================================================
+   INSTRUMENTATION - cout/endl vs counters, measured
+   ----------------------------------------------------------
+   The stock market from observer_design.cpp, one price change
+   = 4 observers notified:
+
+   - endl        : as the example was written, every event is
+                   `out << ... << endl` (one write() per line)
+   - counters    : COUNT_EVENT + TIME_SCOPE + EVENT_LOG, no text
+                   sink attached (the new default)
+   - counters+file sink : same, with a file sink attached, so the
+                   same lines are still written, without a flush
+                   per line
+
+   The text goes to argv[1] (default /dev/null), so the cost is
+   the formatting and the syscalls, not a terminal.
+
+   Build: g++ -std=c++20 -O2 instrumentation_benchmark.cpp
+          g++ -std=c++20 -O2 -DINSTRUMENTATION_OFF instrumentation_benchmark.cpp
+   Run  : ./a.out [text-file] > instrumentation.json
+   ========================================================== */
+
+class Observer {
+public:
+    virtual void update(const string& stockName, float price) = 0;
+    virtual ~Observer() {}
+};
+
+// ---------------- As written: cout << ... << endl ----------------
+namespace endlStyle {
+
+ostream* out;
+
+class StockMarket {
+    vector<Observer*> observers;
+public:
+    void addObserver(Observer* o) { observers.push_back(o); }
+    void notifyObservers(const string& stockName, float price) {
+        for (Observer* obs : observers) obs->update(stockName, price);
+    }
+    void setStockPrice(const string& stockName, float price) {
+        *out << "\n[StockMarket] " << stockName << " new price: $" << price << endl;
+        notifyObservers(stockName, price);
+    }
+};
+
+class MobileApp : public Observer {
+    string owner;
+public:
+    MobileApp(string name) : owner(name) {}
+    void update(const string& stockName, float price) override {
+        *out << "[MobileApp - " << owner << "] " << stockName << " updated price: $" << price << endl;
+    }
+};
+
+class NewsAgency : public Observer {
+public:
+    void update(const string& stockName, float price) override {
+        *out << "[NewsAgency] Breaking news: " << stockName << " hits $" << price << endl;
+    }
+};
+
+}  // namespace endlStyle
+
+// ---------------- Instrumented ----------------
+namespace instrumented {
+
+class StockMarket {
+    vector<Observer*> observers;
+public:
+    void addObserver(Observer* o) { observers.push_back(o); }
+    void notifyObservers(const string& stockName, float price) {
+        TIME_SCOPE("stock.notifyObservers");
+        for (Observer* obs : observers) obs->update(stockName, price);
+    }
+    void setStockPrice(const string& stockName, float price) {
+        COUNT_EVENT("stock.priceChanges");
+        EVENT_LOG("\n[StockMarket] " << stockName << " new price: $" << price);
+        notifyObservers(stockName, price);
+    }
+};
+
+class MobileApp : public Observer {
+    string owner;
+public:
+    MobileApp(string name) : owner(name) {}
+    void update(const string& stockName, float price) override {
+        COUNT_EVENT("observer.mobileApp");
+        EVENT_LOG("[MobileApp - " << owner << "] " << stockName << " updated price: $" << price);
+    }
+};
+
+class NewsAgency : public Observer {
+public:
+    void update(const string& stockName, float price) override {
+        COUNT_EVENT("observer.newsAgency");
+        EVENT_LOG("[NewsAgency] Breaking news: " << stockName << " hits $" << price);
+    }
+};
+
+}  // namespace instrumented
+
+int main(int argc, char** argv) {
+    const uint64_t N = 200000;
+    const string textPath = argc > 1 ? argv[1] : "/dev/null";
+#ifdef INSTRUMENTATION_OFF
+    PatternBench bench("instrumentation (INSTRUMENTATION_OFF)");
+#else
+    PatternBench bench("instrumentation");
+#endif
+    const string stock = "AAPL";
+    float price = 150.5f;
+
+    instrumented::MobileApp alice("Alice"), bob("Bob"), carol("Carol");
+    instrumented::NewsAgency reuters;
+    instrumented::StockMarket market;
+    for (Observer* o : initializer_list<Observer*>{&alice, &bob, &carol, &reuters}) market.addObserver(o);
+
+    bench.run("counters", N, [&] { market.setStockPrice(stock, price += 0.25f); });
+
+    MetricsRegistry::instance().addFileSink(textPath);
+    bench.run("counters+file sink", N, [&] { market.setStockPrice(stock, price += 0.25f); });
+    MetricsRegistry::instance().clearTextSinks();
+
+    ofstream text(textPath, ios::app);
+    endlStyle::out = &text;
+    endlStyle::MobileApp alice2("Alice"), bob2("Bob"), carol2("Carol");
+    endlStyle::NewsAgency reuters2;
+    endlStyle::StockMarket oldMarket;
+    for (Observer* o : initializer_list<Observer*>{&alice2, &bob2, &carol2, &reuters2}) oldMarket.addObserver(o);
+
+    bench.run("endl", N, [&] { oldMarket.setStockPrice(stock, price += 0.25f); });
+
+    bench.report();
+    fprintf(stderr, "\n");
+    MetricsRegistry::instance().printSummary(cerr);
+    return 0;
+}
+
+/* ==========================================================
+   SAMPLE OUTPUT (stderr; numbers depend on the machine)
+   ----------------------------------------------------------
+   === instrumentation ===
+   counters                            93.01 ns/op    0.00 allocs/op      0.0 B/op      n/a instr/op
+   counters+file sink                2758.92 ns/op    5.00 allocs/op    229.0 B/op      n/a instr/op
+   endl                              3421.53 ns/op    0.00 allocs/op      0.0 B/op      n/a instr/op
+
+   metric                           events    samples    p50 ns    p99 ns    max ns
+   stock.priceChanges               440000          0         0         0         0
+   stock.notifyObservers                 0     440000      1695      3647   2207723
+   observer.mobileApp              1320000          0         0         0         0
+   observer.newsAgency              440000          0         0         0         0
+
+   === instrumentation (INSTRUMENTATION_OFF) ===
+   counters                             7.32 ns/op    0.00 allocs/op      0.0 B/op      n/a instr/op
+   counters+file sink                   6.97 ns/op    0.00 allocs/op      0.0 B/op      n/a instr/op
+   endl                              3872.80 ns/op    0.00 allocs/op      0.0 B/op      n/a instr/op
+
+   Takeaways:
+   - Without a text sink a price change costs ~90 ns instead of
+     ~3.4 us: 5 counters plus one TIME_SCOPE. Most of the 90 ns
+     is the two steady_clock reads (~43 ns each on this VM).
+   - Text is still what costs: with a sink attached it is ~2.8 us,
+     because formatting the floats is most of the work. Dropping
+     the per-line flush is the smaller part of the win.
+   - INSTRUMENTATION_OFF leaves only the virtual calls (~7 ns).
+   - The notifyObservers percentiles mix the runs with and without
+     the sink; that is why p50 is 1.7 us.
+   ========================================================== */
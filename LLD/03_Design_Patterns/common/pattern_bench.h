@@ -0,0 +1,179 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/* ==========================================================
+   PATTERN BENCH - what does an abstraction cost per call?
+   ----------------------------------------------------------
+   Small harness shared by the "without vs with" benchmarks:
+
+   - ns/op           : steady_clock over many operations
+   - allocations/op  : global operator new is replaced below and
+                       counts every heap allocation (and bytes)
+   - instructions/op : hardware counter via perf_event_open on
+                       Linux; reported as null when the kernel or
+                       container does not allow it
+
+   Results are printed as JSON on stdout (one object per run),
+   a short table on stderr.
+
+   Include this header from exactly ONE .cpp file: it defines the
+   replacement operator new/delete, which must exist only once
+   in a program. The counters are plain globals, so measure on
+   one thread.
+   ========================================================== */
+
+struct AllocationStats {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
+inline AllocationStats heapAllocations;
+
+void* operator new(std::size_t size) {
+    heapAllocations.count++;
+    heapAllocations.bytes += size;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+// noinline: keeps GCC from pairing the inlined malloc/free with new/delete
+// expressions and warning about a mismatch that is not there.
+[[gnu::noinline]] void operator delete(void* p) noexcept { std::free(p); }
+[[gnu::noinline]] void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+// Keeps a value (and everything it points to) alive and unknown to the optimizer.
+template <typename T>
+inline void doNotOptimize(T& value) {
+    asm volatile("" : "+m"(value) : : "memory");
+}
+
+// ---------------- Instruction counter -----------------
+class InstructionCounter {
+private:
+    int fd = -1;
+
+public:
+    InstructionCounter() {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof attr);
+        attr.size = sizeof attr;
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+    ~InstructionCounter() {
+#ifdef __linux__
+        if (fd >= 0) close(fd);
+#endif
+    }
+    InstructionCounter(const InstructionCounter&) = delete;
+    InstructionCounter& operator=(const InstructionCounter&) = delete;
+
+    bool available() const { return fd >= 0; }
+
+    void start() {
+#ifdef __linux__
+        if (fd < 0) return;
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    // Instructions since start(), or -1 if not available.
+    int64_t stop() {
+#ifdef __linux__
+        if (fd < 0) return -1;
+        ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        int64_t value = 0;
+        if (read(fd, &value, sizeof value) != sizeof value) return -1;
+        return value;
+#else
+        return -1;
+#endif
+    }
+};
+
+// ---------------- Runner -----------------
+struct BenchResult {
+    std::string name;
+    uint64_t ops;
+    double nsPerOp;
+    double allocationsPerOp;
+    double bytesPerOp;
+    double instructionsPerOp;  // < 0 = not available
+};
+
+class PatternBench {
+private:
+    std::string suite;
+    std::vector<BenchResult> results;
+    InstructionCounter instructions;
+
+public:
+    explicit PatternBench(std::string suiteName) : suite(std::move(suiteName)) {}
+
+    // Calls op() `ops` times after a short warm-up and records the cost per call.
+    template <typename Op>
+    void run(const std::string& name, uint64_t ops, Op op) {
+        for (uint64_t i = 0; i < ops / 10; i++) op();
+
+        AllocationStats before = heapAllocations;
+        instructions.start();
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < ops; i++) op();
+        auto end = std::chrono::steady_clock::now();
+        int64_t executed = instructions.stop();
+
+        BenchResult r;
+        r.name = name;
+        r.ops = ops;
+        r.nsPerOp = std::chrono::duration<double, std::nano>(end - start).count() / ops;
+        r.allocationsPerOp = double(heapAllocations.count - before.count) / ops;
+        r.bytesPerOp = double(heapAllocations.bytes - before.bytes) / ops;
+        r.instructionsPerOp = executed < 0 ? -1.0 : double(executed) / ops;
+        results.push_back(r);
+    }
+
+    void report() const {
+        std::fprintf(stderr, "=== %s ===\n", suite.c_str());
+        for (const BenchResult& r : results) {
+            std::fprintf(stderr, "%-32s %8.2f ns/op  %6.2f allocs/op  %7.1f B/op  ", r.name.c_str(), r.nsPerOp,
+                         r.allocationsPerOp, r.bytesPerOp);
+            if (r.instructionsPerOp < 0) std::fprintf(stderr, "    n/a instr/op\n");
+            else std::fprintf(stderr, "%7.1f instr/op\n", r.instructionsPerOp);
+        }
+
+        std::printf("{\"suite\": \"%s\", \"instructions_available\": %s, \"results\": [", suite.c_str(),
+                    instructions.available() ? "true" : "false");
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchResult& r = results[i];
+            std::printf("%s\n  {\"name\": \"%s\", \"ops\": %llu, \"ns_per_op\": %.3f, \"allocations_per_op\": %.3f, "
+                        "\"bytes_per_op\": %.1f, \"instructions_per_op\": ",
+                        i ? "," : "", r.name.c_str(), (unsigned long long)r.ops, r.nsPerOp, r.allocationsPerOp,
+                        r.bytesPerOp);
+            if (r.instructionsPerOp < 0) std::printf("null}");
+            else std::printf("%.1f}", r.instructionsPerOp);
+        }
+        std::printf("\n]}\n");
+    }
+};
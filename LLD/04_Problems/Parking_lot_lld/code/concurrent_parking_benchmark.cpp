@@ -0,0 +1,148 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <chrono>
+#include <memory>
+#include <cstdio>
+#include "concurrent_spot_allocator.h"
+using namespace std;
+
+/* ==========================================================
+   CONCURRENT GATES - stress test + throughput benchmark
+   ----------------------------------------------------------
+   Each thread is one gate. It parks vehicles (entry) and
+   releases random vehicles it parked earlier (exit).
+
+   Stress test: a side table records who owns each spot. A gate
+   that gets a spot already owned by someone else = a ticket
+   assigned twice = FAIL. At the end every free counter must
+   match what is really parked.
+
+   Benchmark: park+unpark operations per second for 1..16 gates.
+   On a machine with fewer cores than gates the extra gates only
+   time-slice, so the curve flattens at the core count.
+
+   Build: g++ -std=c++20 -O2 -pthread concurrent_parking_benchmark.cpp
+   ========================================================== */
+
+using Clock = chrono::steady_clock;
+
+VehicleType randomVehicle(mt19937& rng) {
+    int r = uniform_int_distribution<int>(0, 9)(rng);
+    return r < 2 ? VehicleType::Motorcycle : r < 9 ? VehicleType::Car : VehicleType::Truck;
+}
+
+struct RunResult {
+    double opsPerSec;
+    long doubleAssigned;
+    long failedParks;
+    bool countsMatch;
+};
+
+// Each gate keeps the lot close to `fillRatio` full by parking when below
+// its share and releasing a random one of its vehicles otherwise.
+RunResult runGates(const LotLayout& layout, int gates, int opsPerGate, double fillRatio, bool checkOwners) {
+    ConcurrentSpotAllocator lot(layout);
+    size_t total = lot.totalSpots();
+    size_t targetPerGate = size_t(total * fillRatio / gates);
+
+    unique_ptr<atomic<uint32_t>[]> owner;
+    if (checkOwners) owner = make_unique<atomic<uint32_t>[]>(total);
+
+    atomic<long> doubleAssigned{0}, failedParks{0};
+    vector<vector<SpotId>> parked(gates);
+    atomic<int> ready{0};
+    atomic<bool> go{false};
+
+    auto gate = [&](int g) {
+        mt19937 rng(1000 + g);
+        vector<SpotId>& mine = parked[g];
+        mine.reserve(targetPerGate + 16);
+        int home = g * lot.shardCount() / gates;
+
+        ready++;
+        while (!go.load()) this_thread::yield();
+
+        for (int i = 0; i < opsPerGate; i++) {
+            bool enter = mine.size() < targetPerGate || (rng() & 1);
+            if (enter || mine.empty()) {
+                auto spot = lot.park(randomVehicle(rng), home);
+                if (!spot) { failedParks++; continue; }
+                if (checkOwners) {
+                    uint32_t expected = 0;
+                    if (!owner[lot.flatIndex(*spot)].compare_exchange_strong(expected, g + 1)) doubleAssigned++;
+                }
+                mine.push_back(*spot);
+            } else {
+                size_t k = rng() % mine.size();
+                SpotId s = mine[k];
+                mine[k] = mine.back();
+                mine.pop_back();
+                if (checkOwners) owner[lot.flatIndex(s)].store(0);  // before the spot is visible as free
+                lot.unpark(s);
+            }
+        }
+    };
+
+    vector<thread> threads;
+    for (int g = 0; g < gates; g++) threads.emplace_back(gate, g);
+    while (ready.load() < gates) this_thread::yield();
+    auto start = Clock::now();
+    go.store(true);
+    for (thread& t : threads) t.join();
+    double secs = chrono::duration<double>(Clock::now() - start).count();
+
+    // Free counters must agree with what the gates think is parked
+    size_t parkedPerType[SPOT_TYPE_COUNT] = {};
+    for (auto& mine : parked) {
+        for (const SpotId& s : mine) parkedPerType[int(s.type)]++;
+    }
+    bool countsMatch = true;
+    for (int t = 0; t < SPOT_TYPE_COUNT; t++) {
+        size_t capacity = size_t(layout.floors) * layout.spotsPerFloor[t];
+        if (lot.freeSpotsOfType(SpotType(t)) + parkedPerType[t] != capacity) countsMatch = false;
+    }
+
+    return {double(gates) * opsPerGate / secs, doubleAssigned.load(), failedParks.load(), countsMatch};
+}
+
+int main() {
+    // Stress: a small lot so gates constantly fight over the same words,
+    // running at ~99% full so the lot is often full for some types.
+    cout << "=== Stress test: 8 gates, 4 floors x (64, 256, 32) spots, ~99% full ===\n";
+    RunResult stress = runGates(LotLayout{4, {64, 256, 32}}, 8, 500000, 0.99, true);
+    printf("double-assigned: %ld, failed parks (lot full): %ld, free counters %s -> %s\n",
+           stress.doubleAssigned, stress.failedParks, stress.countsMatch ? "consistent" : "WRONG",
+           stress.doubleAssigned == 0 && stress.countsMatch ? "PASS" : "FAIL");
+
+    cout << "\n=== Throughput vs gates: 20 floors x (10k, 30k, 10k) = 1M spots, 80% full ===\n";
+    cout << "hardware threads: " << thread::hardware_concurrency() << "\n";
+    for (int gates : {1, 2, 4, 8, 16}) {
+        RunResult r = runGates(LotLayout{20, {10000, 30000, 10000}}, gates, 2000000 / gates, 0.8, false);
+        printf("%2d gates: %6.2f M ops/s\n", gates, r.opsPerSec / 1e6);
+    }
+    return 0;
+}
+
+/* ==========================================================
+   SAMPLE OUTPUT (1-core VM; numbers depend on the machine)
+   ----------------------------------------------------------
+   === Stress test: 8 gates, 4 floors x (64, 256, 32) spots, ~99% full ===
+   double-assigned: 0, failed parks (lot full): 1355484, free counters consistent -> PASS
+
+   === Throughput vs gates: 20 floors x (10k, 30k, 10k) = 1M spots, 80% full ===
+   hardware threads: 1
+    1 gates:  12.79 M ops/s
+    2 gates:  12.90 M ops/s
+    4 gates:  13.94 M ops/s
+    8 gates:  15.80 M ops/s
+   16 gates:  17.73 M ops/s
+
+   With one core the gates never truly overlap, so this only shows
+   that adding gates costs nothing. With real cores, gates in
+   different home shards touch different cache lines and scale
+   until they start stealing from each other's floors.
+   The stress test also passes under -fsanitize=thread.
+   ========================================================== */
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <thread>
+
+#include "spot_allocator.h"
+
+/* ==========================================================
+   CONCURRENT SPOT ALLOCATOR - many gates, no global lock
+   ----------------------------------------------------------
+   Same idea as SpotAllocator (bit = free spot), but safe for
+   many entry/exit gates at once:
+
+   - The lot is split into shards, one per floor. Each shard has,
+     per spot type, atomic 64-bit leaf words plus one level of
+     atomic summary words ("this leaf word may have a free spot").
+   - A gate claims a spot by clearing its bit with fetch_and.
+     Only the thread that actually saw the bit go 1 -> 0 owns the
+     spot, so a spot can never be handed out twice.
+   - Each gate starts in its home shard (the floor next to it) and
+     steals from the other shards only when that one is full for
+     the vehicle's spot type.
+   - Summary bits are hints: a claimer that empties a leaf word
+     clears the hint and then re-checks the word, so a spot freed
+     at the same moment is never hidden.
+   - Each shard packs its three free counters (21 bits per type)
+     into one padded 64-bit atomic. Display boards read a floor
+     with a single load: wait-free, never a torn mix of types,
+     and the cost does not depend on how many spots there are.
+     The 21-bit fields limit a floor to 1<<20 spots per type;
+     the constructor rejects larger layouts.
+   - Every counter change is bracketed by two per-floor write
+     counts (started, done) on the same cache line. A snapshot
+     of all floors reads them around the counters and retries if
+     any floor was being written, so it shows the whole lot as it
+     was at one instant. Gates on different floors still share
+     no cache line.
+   ========================================================== */
+
+// Free spots on one floor, all three types taken from one atomic load.
+struct FloorOccupancy {
+    uint32_t freeSpots[SPOT_TYPE_COUNT];  // compact, regular, oversized
+};
+
+class ConcurrentSpotAllocator {
+private:
+    static constexpr int COUNT_BITS = 21;
+    static constexpr uint64_t COUNT_MASK = (uint64_t(1) << COUNT_BITS) - 1;
+    static constexpr uint32_t MAX_SPOTS_PER_TYPE = 1u << 20;  // per floor; headroom for in-flight updates
+
+    struct TypeBits {
+        uint32_t spots = 0;
+        size_t leafWords = 0;
+        std::unique_ptr<std::atomic<uint64_t>[]> leaf;      // bit = spot is free
+        std::unique_ptr<std::atomic<uint64_t>[]> summary;   // bit = leaf word may have a free spot
+        size_t summaryWords = 0;
+    };
+
+    struct Shard {
+        TypeBits types[SPOT_TYPE_COUNT];
+        alignas(64) std::atomic<uint64_t> freeCounts{0};  // type t in bits [21t, 21t + 21)
+        std::atomic<uint64_t> writesStarted{0};            // see CountWrite
+        std::atomic<uint64_t> writesDone{0};
+        char pad[64 - 3 * sizeof(std::atomic<uint64_t>)];
+    };
+
+    // Scope of one change to a shard's freeCounts. While started != done
+    // a write is in flight and occupancySnapshot() retries.
+    class CountWrite {
+        Shard& shard;
+
+    public:
+        explicit CountWrite(Shard& s) : shard(s) { shard.writesStarted.fetch_add(1); }
+        ~CountWrite() { shard.writesDone.fetch_add(1); }
+    };
+
+    static uint64_t countUnit(SpotType t) { return uint64_t(1) << (COUNT_BITS * int(t)); }
+    static uint32_t countOf(uint64_t packed, int t) { return uint32_t((packed >> (COUNT_BITS * t)) & COUNT_MASK); }
+    static FloorOccupancy unpack(uint64_t packed) {
+        return FloorOccupancy{{countOf(packed, 0), countOf(packed, 1), countOf(packed, 2)}};
+    }
+
+    LotLayout layout;
+    std::unique_ptr<Shard[]> shards;
+
+    static void initBits(TypeBits& tb, uint32_t spots) {
+        tb.spots = spots;
+        tb.leafWords = (spots + 63) / 64;
+        tb.summaryWords = (tb.leafWords + 63) / 64;
+        tb.leaf = std::make_unique<std::atomic<uint64_t>[]>(tb.leafWords);
+        tb.summary = std::make_unique<std::atomic<uint64_t>[]>(tb.summaryWords);
+        for (size_t w = 0; w < tb.leafWords; w++) {
+            size_t remaining = spots - w * 64;
+            tb.leaf[w].store(remaining >= 64 ? ~uint64_t(0) : (uint64_t(1) << remaining) - 1,
+                             std::memory_order_relaxed);
+            tb.summary[w >> 6].fetch_or(uint64_t(1) << (w & 63), std::memory_order_relaxed);
+        }
+    }
+
+    // Tries to claim the lowest free spot of type t in one shard; -1 if none.
+    static int64_t claimIn(Shard& shard, SpotType t) {
+        if (countOf(shard.freeCounts.load(std::memory_order_relaxed), int(t)) == 0) return -1;
+        TypeBits& tb = shard.types[int(t)];
+
+        for (size_t s = 0; s < tb.summaryWords; s++) {
+            uint64_t hints = tb.summary[s].load(std::memory_order_acquire);
+            while (hints) {
+                size_t w = s * 64 + std::countr_zero(hints);
+                hints &= hints - 1;
+
+                uint64_t word = tb.leaf[w].load(std::memory_order_acquire);
+                if (word == 0) clearHint(tb, w);  // stale hint
+                while (word) {
+                    uint64_t bit = word & -word;
+                    uint64_t old = tb.leaf[w].fetch_and(~bit, std::memory_order_acq_rel);
+                    if (old & bit) {
+                        if (old == bit) clearHint(tb, w);
+                        CountWrite write(shard);
+                        shard.freeCounts.fetch_sub(countUnit(t), std::memory_order_release);
+                        return int64_t(w * 64 + std::countr_zero(bit));
+                    }
+                    word = old & ~bit;  // someone beat us to it; try the next free bit
+                }
+            }
+        }
+        return -1;
+    }
+
+    // Leaf word w looked empty: clear its hint, then undo that if a
+    // release refilled the word in the meantime (seq_cst on purpose).
+    static void clearHint(TypeBits& tb, size_t w) {
+        uint64_t hintBit = uint64_t(1) << (w & 63);
+        tb.summary[w >> 6].fetch_and(~hintBit);
+        if (tb.leaf[w].load() != 0) tb.summary[w >> 6].fetch_or(hintBit);
+    }
+
+public:
+    explicit ConcurrentSpotAllocator(const LotLayout& l) : layout(l) {
+        if (l.floors <= 0 || l.floors > UINT16_MAX) throw std::invalid_argument("bad floor count");
+        for (int t = 0; t < SPOT_TYPE_COUNT; t++) {
+            if (l.spotsPerFloor[t] > MAX_SPOTS_PER_TYPE) throw std::invalid_argument("too many spots of one type per floor");
+        }
+        shards = std::make_unique<Shard[]>(l.floors);
+        for (int f = 0; f < l.floors; f++) {
+            uint64_t packed = 0;
+            for (int t = 0; t < SPOT_TYPE_COUNT; t++) {
+                initBits(shards[f].types[t], l.spotsPerFloor[t]);
+                packed |= uint64_t(l.spotsPerFloor[t]) << (COUNT_BITS * t);
+            }
+            shards[f].freeCounts.store(packed, std::memory_order_relaxed);
+        }
+    }
+
+    int shardCount() const { return layout.floors; }
+
+    // Smallest fitting spot type first; within a type, the gate's home shard
+    // first and then the other shards in order (work stealing).
+    std::optional<SpotId> park(VehicleType v, int homeShard) {
+        SpotChoices choices = spotChoicesFor(v);
+        int n = layout.floors;
+        homeShard %= n;
+        if (homeShard < 0) homeShard += n;  // any gate id maps to a floor
+        for (int c = 0; c < choices.count; c++) {
+            SpotType t = choices.types[c];
+            for (int k = 0; k < n; k++) {
+                int floor = (homeShard + k) % n;
+                int64_t index = claimIn(shards[floor], t);
+                if (index >= 0) return SpotId{uint16_t(floor), t, uint32_t(index)};
+            }
+        }
+        return std::nullopt;
+    }
+
+    // Returns false if the spot does not exist or was already free.
+    bool unpark(SpotId id) {
+        if (id.floor >= layout.floors || id.index >= layout.spotsPerFloor[int(id.type)]) return false;
+        Shard& shard = shards[id.floor];
+        TypeBits& tb = shard.types[int(id.type)];
+        size_t w = id.index / 64;
+        uint64_t bit = uint64_t(1) << (id.index % 64);
+
+        // Count first, publish the bit second: a claimer can only take this
+        // spot after the count includes it, so a field never drops below
+        // zero and borrows from its neighbour.
+        CountWrite write(shard);
+        shard.freeCounts.fetch_add(countUnit(id.type), std::memory_order_release);
+        uint64_t old = tb.leaf[w].fetch_or(bit, std::memory_order_acq_rel);
+        if (old & bit) {
+            shard.freeCounts.fetch_sub(countUnit(id.type), std::memory_order_release);
+            return false;
+        }
+        tb.summary[w >> 6].fetch_or(uint64_t(1) << (w & 63));
+        return true;
+    }
+
+    bool isFree(SpotId id) const {
+        const TypeBits& tb = shards[id.floor].types[int(id.type)];
+        return (tb.leaf[id.index / 64].load(std::memory_order_acquire) >> (id.index % 64)) & 1;
+    }
+
+    // One atomic load, wait-free. It does not wait for writes in flight, so
+    // an unpark in progress (or one repeated on an already free spot) can
+    // show up for a moment before it settles. Use occupancySnapshot() for
+    // a consistent view.
+    FloorOccupancy floorOccupancy(int floor) const {
+        return unpack(shards[floor].freeCounts.load(std::memory_order_acquire));
+    }
+
+    // Fills out[f] for every floor (out.size() must be shardCount()) with the
+    // whole lot as it was at one instant: no write was in flight on any floor
+    // and none started between the first and the last read. Retries until a
+    // pass sees that; it never blocks a gate.
+    void occupancySnapshot(std::span<FloorOccupancy> out) const {
+        if (out.size() != size_t(layout.floors)) throw std::invalid_argument("snapshot needs one entry per floor");
+        while (true) {
+            bool quiet = true;
+            uint64_t started = 0;  // the per-floor counts only grow, so equal sums mean equal counts
+            for (int f = 0; f < layout.floors; f++) {
+                const Shard& s = shards[f];
+                uint64_t done = s.writesDone.load();
+                uint64_t begun = s.writesStarted.load();
+                quiet &= done == begun;
+                started += begun;
+                out[f] = unpack(s.freeCounts.load(std::memory_order_acquire));
+            }
+            if (quiet) {
+                for (int f = 0; f < layout.floors; f++) started -= shards[f].writesStarted.load();
+                if (started == 0) return;
+            }
+            std::this_thread::yield();  // let the writer in flight finish
+        }
+    }
+
+    size_t freeSpotsOfType(SpotType t) const {
+        size_t n = 0;
+        for (int f = 0; f < layout.floors; f++) n += countOf(shards[f].freeCounts.load(std::memory_order_acquire), int(t));
+        return n;
+    }
+
+    // Dense index in [0, totalSpots()), handy for per-spot side tables.
+    size_t flatIndex(SpotId id) const {
+        size_t perFloor = 0, offset = 0;
+        for (int t = 0; t < SPOT_TYPE_COUNT; t++) {
+            if (t < int(id.type)) offset += layout.spotsPerFloor[t];
+            perFloor += layout.spotsPerFloor[t];
+        }
+        return id.floor * perFloor + offset + id.index;
+    }
+
+    size_t totalSpots() const {
+        size_t n = 0;
+        for (int t = 0; t < SPOT_TYPE_COUNT; t++) n += size_t(layout.floors) * layout.spotsPerFloor[t];
+        return n;
+    }
+
+    const LotLayout& lotLayout() const { return layout; }
+};
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+#include "spot_allocator.h"
+
+/* ==========================================================
+   FEE ENGINE - O(1) fee per stay, SIMD batches
+   ----------------------------------------------------------
+   The rate schedule ("7:00-19:00 a car pays 120 cents/hour")
+   is compiled once into a prefix table per vehicle size:
+
+     prefix[size][m] = cost of minutes 0..m-1 of one day
+
+   Cost from time 0 to minute t is then
+     (t / 1440) * dayTotal[size] + prefix[size][t % 1440]
+   and the fee for a stay is cost(exit) - cost(entry): two table
+   reads, whatever the length of the stay.
+
+   Costs are counted in 1/60 cent (a minute at R cents/hour adds
+   R), so every intermediate value is an exact whole number and
+   the scalar and SIMD paths round to the same cent.
+
+   Fees are int32 cents. The constructor works out the longest
+   stay whose fee fits for every vehicle type (maxStayMinutes()),
+   and both entry points reject longer stays.
+
+   feeBatch() works on columns (entry[], exit[], vehicle[]) and,
+   when built with AVX2, handles 4 stays per instruction using
+   gathers from the prefix tables.
+   ========================================================== */
+
+constexpr int MINUTES_PER_DAY = 1440;
+
+// Minutes [startMinute, endMinute) of every day cost centsPerHour[vehicle].
+struct RateRule {
+    uint16_t startMinute;
+    uint16_t endMinute;
+    uint32_t centsPerHour[3];  // motorcycle, car, truck
+};
+
+class FeeEngine {
+private:
+    static constexpr int TABLE = MINUTES_PER_DAY + 1;
+
+    // [vehicle * TABLE + minute], in 1/60 cent; doubles so AVX2 can gather them
+    std::vector<double> prefix;
+    double dayUnits[3] = {};
+    uint32_t maxStay = INT32_MAX;
+
+    static int32_t toCents(double units) { return int32_t(std::nearbyint(units / 60.0)); }
+
+    // The AVX2 path converts minutes as signed 32-bit ints.
+    void checkStay(VehicleType v, uint32_t entryMinute, uint32_t exitMinute) const {
+        if (uint8_t(v) >= 3) throw std::invalid_argument("unknown vehicle type");
+        if (exitMinute < entryMinute) throw std::invalid_argument("exit before entry");
+        if (exitMinute > uint32_t(INT32_MAX)) throw std::out_of_range("minute must be below 2^31");
+        if (exitMinute - entryMinute > maxStay) throw std::out_of_range("stay too long for an int32 fee");
+    }
+
+    // Same operations, in the same order, as one lane of the AVX2 path.
+    double stayUnits(int v, uint32_t entryMinute, uint32_t exitMinute) const {
+        double days = double(exitMinute / MINUTES_PER_DAY) - double(entryMinute / MINUTES_PER_DAY);
+        return days * dayUnits[v] + (prefix[v * TABLE + exitMinute % MINUTES_PER_DAY] -
+                                     prefix[v * TABLE + entryMinute % MINUTES_PER_DAY]);
+    }
+
+    // Most expensive `length` minutes (less than a day) for vehicle v, over every start minute.
+    int64_t maxWindowUnits(int v, int length) const {
+        int64_t best = 0;
+        for (int s = 0; s < MINUTES_PER_DAY; s++) {
+            int e = s + length;
+            double u = e <= MINUTES_PER_DAY ? prefix[v * TABLE + e] - prefix[v * TABLE + s]
+                                            : dayUnits[v] - prefix[v * TABLE + s] + prefix[v * TABLE + e - MINUTES_PER_DAY];
+            best = std::max(best, int64_t(u));
+        }
+        return best;
+    }
+
+    // A stay of d whole days plus r minutes costs at most d * day + maxWindowUnits(r).
+    // Finds the largest such stay that still rounds to at most INT32_MAX cents.
+    void computeMaxStay() {
+        const int64_t limit = int64_t(INT32_MAX) * 60 + 29;
+        for (int v = 0; v < 3; v++) {
+            int64_t day = int64_t(dayUnits[v]);
+            if (day == 0) continue;
+            int64_t days = limit / day;
+            int lo = 0, hi = MINUTES_PER_DAY - 1;
+            while (lo < hi) {
+                int mid = (lo + hi + 1) / 2;
+                if (days * day + maxWindowUnits(v, mid) <= limit) lo = mid;
+                else hi = mid - 1;
+            }
+            maxStay = uint32_t(std::min<int64_t>(maxStay, days * MINUTES_PER_DAY + lo));
+        }
+    }
+
+public:
+    // Minutes not covered by any rule are free. Rules must not overlap.
+    explicit FeeEngine(const std::vector<RateRule>& rules) : prefix(3 * TABLE, 0.0) {
+        std::vector<int64_t> rate(3 * MINUTES_PER_DAY, -1);
+        for (const RateRule& r : rules) {
+            if (r.startMinute >= r.endMinute || r.endMinute > MINUTES_PER_DAY) throw std::invalid_argument("bad rate rule");
+            for (int m = r.startMinute; m < r.endMinute; m++) {
+                for (int v = 0; v < 3; v++) {
+                    if (rate[v * MINUTES_PER_DAY + m] >= 0) throw std::invalid_argument("overlapping rate rules");
+                    rate[v * MINUTES_PER_DAY + m] = r.centsPerHour[v];
+                }
+            }
+        }
+        for (int v = 0; v < 3; v++) {
+            int64_t sum = 0;
+            for (int m = 0; m < MINUTES_PER_DAY; m++) {
+                prefix[v * TABLE + m] = double(sum);
+                sum += std::max<int64_t>(rate[v * MINUTES_PER_DAY + m], 0);
+            }
+            prefix[v * TABLE + MINUTES_PER_DAY] = double(sum);
+            dayUnits[v] = double(sum);
+        }
+        computeMaxStay();
+    }
+
+    // Longest stay, in minutes, that fee() and feeBatch() accept.
+    uint32_t maxStayMinutes() const { return maxStay; }
+
+    // Minutes are counted from a fixed midnight and must be below 2^31.
+    // Throws for an unknown vehicle type, a stay that ends before it
+    // starts, or one longer than maxStayMinutes().
+    int32_t fee(VehicleType v, uint32_t entryMinute, uint32_t exitMinute) const {
+        checkStay(v, entryMinute, exitMinute);
+        return toCents(stayUnits(int(v), entryMinute, exitMinute));
+    }
+
+    // out[i] = fee(vehicle[i], entry[i], exit[i]), with the same checks as
+    // fee(). Nothing is written if any stay is rejected.
+    void feeBatch(std::span<const uint32_t> entry, std::span<const uint32_t> exit,
+                  std::span<const VehicleType> vehicle, std::span<int32_t> out) const {
+        size_t n = entry.size();
+        if (exit.size() != n || vehicle.size() != n || out.size() != n) throw std::invalid_argument("column sizes differ");
+        // Branch-free scan first; checkStay() then reports the first bad stay.
+        bool bad = false;
+        for (size_t k = 0; k < n; k++) {
+            bad |= (uint8_t(vehicle[k]) >= 3) | (exit[k] < entry[k]) | (exit[k] > uint32_t(INT32_MAX)) |
+                   (exit[k] - entry[k] > maxStay);
+        }
+        if (bad) {
+            for (size_t k = 0; k < n; k++) checkStay(vehicle[k], entry[k], exit[k]);
+        }
+
+        size_t i = 0;
+#ifdef __AVX2__
+        const __m256d day = _mm256_set1_pd(MINUTES_PER_DAY);
+        const __m256d half = _mm256_set1_pd(0.5);
+        const __m256d sixty = _mm256_set1_pd(60.0);
+        const __m128i tableStride = _mm_set1_epi32(TABLE);
+        const __m256d allLanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+
+        auto gather = [&](const double* base, __m128i index) {
+            return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), base, index, allLanes, 8);
+        };
+
+        // Splits minutes into (whole days, minute of day). (t + 0.5) / 1440 is never
+        // a whole number, so floor() cannot be pushed across one by rounding.
+        auto split = [&](__m128i minutes, __m256d& days) {
+            __m256d t = _mm256_cvtepi32_pd(minutes);
+            days = _mm256_floor_pd(_mm256_div_pd(_mm256_add_pd(t, half), day));
+            return _mm256_cvttpd_epi32(_mm256_sub_pd(t, _mm256_mul_pd(days, day)));
+        };
+
+        for (; i + 4 <= n; i += 4) {
+            int32_t sizes4;
+            memcpy(&sizes4, vehicle.data() + i, 4);
+            __m128i size = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(sizes4));
+            __m128i row = _mm_mullo_epi32(size, tableStride);
+
+            __m256d entryDays, exitDays;
+            __m128i entryMod = split(_mm_loadu_si128((const __m128i*)(entry.data() + i)), entryDays);
+            __m128i exitMod = split(_mm_loadu_si128((const __m128i*)(exit.data() + i)), exitDays);
+
+            __m256d entryPrefix = gather(prefix.data(), _mm_add_epi32(row, entryMod));
+            __m256d exitPrefix = gather(prefix.data(), _mm_add_epi32(row, exitMod));
+            __m256d perDay = gather(dayUnits, size);
+
+            __m256d units = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(exitDays, entryDays), perDay),
+                                          _mm256_sub_pd(exitPrefix, entryPrefix));
+            __m256d cents = _mm256_round_pd(_mm256_div_pd(units, sixty), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+            _mm_storeu_si128((__m128i*)(out.data() + i), _mm256_cvtpd_epi32(cents));
+        }
+#endif
+        for (; i < n; i++) {
+            out[i] = toCents(stayUnits(int(vehicle[i]), entry[i], exit[i]));
+        }
+    }
+
+    static bool vectorized() {
+#ifdef __AVX2__
+        return true;
+#else
+        return false;
+#endif
+    }
+};
@@ -0,0 +1,170 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include "fee_engine.h"
+using namespace std;
+
+/* ==========================================================
+   FEE ENGINE BENCHMARK - nightly re-billing of 10M exits
+   ----------------------------------------------------------
+   1. Rule walker: for every day of the stay, intersect the stay
+      with every rate rule (what a straightforward implementation
+      does). Cost grows with stay length x number of rules.
+   2. Prefix tables, one stay at a time (FeeEngine::fee).
+   3. Prefix tables, columns at once (FeeEngine::feeBatch);
+      AVX2 when compiled with -mavx2, plain loop otherwise.
+   All three must produce the same cents for every stay.
+   A last check runs an expensive schedule at the longest stay
+   FeeEngine accepts (maxStayMinutes()) and one minute past it.
+
+   Build: g++ -std=c++20 -O2 -mavx2 fee_engine_benchmark.cpp
+   ========================================================== */
+
+using Clock = chrono::steady_clock;
+
+// Reference: walk the rules day by day, same 1/60-cent units as FeeEngine.
+int64_t unitsByRules(const vector<RateRule>& rules, VehicleType v, uint32_t entry, uint32_t exit) {
+    int64_t units = 0;
+    for (uint32_t d = entry / MINUTES_PER_DAY; d <= exit / MINUTES_PER_DAY; d++) {
+        int64_t dayStart = int64_t(d) * MINUTES_PER_DAY;
+        for (const RateRule& r : rules) {
+            int64_t from = max<int64_t>(entry, dayStart + r.startMinute);
+            int64_t to = min<int64_t>(exit, dayStart + r.endMinute);
+            if (to > from) units += (to - from) * r.centsPerHour[int(v)];
+        }
+    }
+    return units;
+}
+
+int32_t feeByRules(const vector<RateRule>& rules, VehicleType v, uint32_t entry, uint32_t exit) {
+    return int32_t(nearbyint(unitsByRules(rules, v, entry, exit) / 60.0));
+}
+
+// Every start minute of a day, at exactly maxStayMinutes(): scalar and batch
+// agree with the reference and fit in int32. One minute more must overflow
+// for some start (so the bound is tight) and must be rejected.
+bool checkLongestStay(const vector<RateRule>& rules) {
+    FeeEngine engine(rules);
+    uint32_t longest = engine.maxStayMinutes();
+    const int64_t limit = int64_t(INT32_MAX) * 60 + 29;  // largest units that round to <= INT32_MAX cents
+    bool ok = true, tight = false;
+
+    for (VehicleType v : {VehicleType::Motorcycle, VehicleType::Car, VehicleType::Truck}) {
+        vector<uint32_t> entry(MINUTES_PER_DAY), exit(MINUTES_PER_DAY);
+        vector<VehicleType> vehicle(MINUTES_PER_DAY, v);
+        vector<int32_t> batch(MINUTES_PER_DAY);
+        for (int s = 0; s < MINUTES_PER_DAY; s++) {
+            entry[s] = 1000u * MINUTES_PER_DAY + s;
+            exit[s] = entry[s] + longest;
+        }
+        engine.feeBatch(entry, exit, vehicle, batch);
+        for (int s = 0; s < MINUTES_PER_DAY; s++) {
+            int64_t units = unitsByRules(rules, v, entry[s], exit[s]);
+            ok &= units <= limit && batch[s] == feeByRules(rules, v, entry[s], exit[s]) &&
+                  engine.fee(v, entry[s], exit[s]) == batch[s];
+            tight |= unitsByRules(rules, v, entry[s], exit[s] + 1) > limit;
+        }
+    }
+    bool rejected = false;
+    try {
+        engine.fee(VehicleType::Truck, 0, longest + 1);
+    } catch (const out_of_range&) {
+        rejected = true;
+    }
+    printf("Longest stay %u min (%.1f days): fits=%s, +1 min overflows=%s, rejected=%s -> %s\n",
+           longest, longest / double(MINUTES_PER_DAY), ok ? "yes" : "no", tight ? "yes" : "no",
+           rejected ? "yes" : "no", ok && tight && rejected ? "OK" : "FAIL");
+    return ok && tight && rejected;
+}
+
+int main() {
+    // Night 0-7 cheap, weekday-style peak 8-10 and 17-19, normal in between.
+    vector<RateRule> rules = {
+        {0, 7 * 60, {20, 40, 80}},
+        {7 * 60, 8 * 60, {40, 80, 160}},
+        {8 * 60, 10 * 60, {90, 180, 360}},
+        {10 * 60, 17 * 60, {50, 100, 200}},
+        {17 * 60, 19 * 60, {90, 180, 360}},
+        {19 * 60, 22 * 60, {40, 80, 160}},
+        {22 * 60, 24 * 60, {20, 40, 80}},
+    };
+    FeeEngine engine(rules);
+
+    // 10M exits over a 90-day window: median stay ~2h, a long tail of multi-day stays.
+    const size_t N = 10000000;
+    mt19937 rng(11);
+    lognormal_distribution<double> stay(log(120.0), 1.3);
+    uniform_int_distribution<uint32_t> start(0, 90 * MINUTES_PER_DAY);
+    vector<uint32_t> entry(N), exit(N);
+    vector<VehicleType> vehicle(N);
+    for (size_t i = 0; i < N; i++) {
+        entry[i] = start(rng);
+        exit[i] = entry[i] + uint32_t(min(stay(rng), 30.0 * MINUTES_PER_DAY));
+        int r = int(rng() % 10);
+        vehicle[i] = r < 2 ? VehicleType::Motorcycle : r < 9 ? VehicleType::Car : VehicleType::Truck;
+    }
+
+    cout << "=== Fees for " << N << " stays, " << rules.size() << " rate rules ===\n";
+    cout << "feeBatch uses " << (FeeEngine::vectorized() ? "AVX2 (4 stays per step)" : "the scalar loop") << "\n";
+
+    vector<int32_t> byRules(N), single(N), batch(N);
+
+    auto t0 = Clock::now();
+    for (size_t i = 0; i < N; i++) byRules[i] = feeByRules(rules, vehicle[i], entry[i], exit[i]);
+    double rulesNs = chrono::duration<double, nano>(Clock::now() - t0).count() / N;
+
+    t0 = Clock::now();
+    for (size_t i = 0; i < N; i++) single[i] = engine.fee(vehicle[i], entry[i], exit[i]);
+    double singleNs = chrono::duration<double, nano>(Clock::now() - t0).count() / N;
+
+    t0 = Clock::now();
+    engine.feeBatch(entry, exit, vehicle, batch);
+    double batchNs = chrono::duration<double, nano>(Clock::now() - t0).count() / N;
+
+    size_t mismatches = 0;
+    long long totalCents = 0;
+    for (size_t i = 0; i < N; i++) {
+        if (single[i] != byRules[i] || batch[i] != byRules[i]) mismatches++;
+        totalCents += batch[i];
+    }
+
+    printf("Rule walker      %6.2f ns/stay  (%6.1f M stays/s)\n", rulesNs, 1e3 / rulesNs);
+    printf("Prefix, scalar   %6.2f ns/stay  (%6.1f M stays/s)\n", singleNs, 1e3 / singleNs);
+    printf("Prefix, batch    %6.2f ns/stay  (%6.1f M stays/s)\n", batchNs, 1e3 / batchNs);
+    printf("billed %.2f total, mismatches: %zu -> %s\n", totalCents / 100.0, mismatches, mismatches ? "FAIL" : "OK");
+
+    // Valet rates of $2.5k-$50k per hour: about a month of parking reaches 2^31 cents.
+    vector<RateRule> valet = {
+        {0, 8 * 60, {250000, 500000, 1000000}},
+        {8 * 60, 20 * 60, {2500000, 5000000, 1000000}},
+        {20 * 60, 24 * 60, {250000, 500000, 1000000}},
+    };
+    bool boundaryOk = checkLongestStay(valet);
+    return mismatches == 0 && boundaryOk ? 0 : 1;
+}
+
+/* ==========================================================
+   SAMPLE OUTPUT (numbers depend on the machine)
+   ----------------------------------------------------------
+   $ g++ -std=c++20 -O2 -mavx2 ...
+   === Fees for 10000000 stays, 7 rate rules ===
+   feeBatch uses AVX2 (4 stays per step)
+   Rule walker       34.83 ns/stay  (  28.7 M stays/s)
+   Prefix, scalar     5.80 ns/stay  ( 172.3 M stays/s)
+   Prefix, batch      4.82 ns/stay  ( 207.3 M stays/s)
+   billed 40591360.36 total, mismatches: 0 -> OK
+   Longest stay 46505 min (32.3 days): fits=yes, +1 min overflows=yes, rejected=yes -> OK
+
+   $ g++ -std=c++20 -O2 ...   (no AVX2)
+   Prefix, batch      7.04 ns/stay  ( 142.0 M stays/s)
+
+   Takeaways:
+   - Prefix tables make a stay cost the same whether it lasts ten
+     minutes or ten days; the rule walker pays for every day x rule.
+   - The whole table is 3 x 1441 doubles (~34 KB) and stays in L1/L2,
+     so the batch is limited by arithmetic, not memory. AVX2 saves
+     the days/minute-of-day split and the rounding per lane.
+   ========================================================== */
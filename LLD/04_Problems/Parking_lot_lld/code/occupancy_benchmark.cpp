@@ -0,0 +1,210 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <chrono>
+#include <cstdio>
+#include "concurrent_spot_allocator.h"
+using namespace std;
+
+/* ==========================================================
+   OCCUPANCY SNAPSHOTS - read cost vs lot size
+   ----------------------------------------------------------
+   Display boards ask "how many free spots of each type on
+   floor f?" many times a second.
+
+   1. Scan     : look at every spot (what a design without
+                 counters has to do). Grows with the lot.
+   2. Floor    : floorOccupancy(f), one atomic load.
+   3. Snapshot : occupancySnapshot(), a consistent view of all
+                 floors (retries if a floor changed meanwhile).
+
+   The lot always has 10 floors and grows from 50K to 10M spots,
+   so (2) and (3) should stay flat while (1) grows.
+   Last part: a board keeps reading while gates park and unpark,
+   and checks that no floor ever shows an impossible count. Then
+   valets move cars between the top and bottom floors (park the
+   new spot, then free the old one), and every snapshot must show
+   between 1 and 2 cars per valet: a torn read that saw one floor
+   before a move and the other after it would show 0 or 3.
+
+   Build: g++ -std=c++20 -O2 -pthread occupancy_benchmark.cpp
+   ========================================================== */
+
+using Clock = chrono::steady_clock;
+
+volatile uint64_t sink;  // keeps the timed reads from being optimized away
+
+// The no-counter way: visit every spot.
+FloorOccupancy scanFloor(const ConcurrentSpotAllocator& lot, int floor) {
+    FloorOccupancy occ{};
+    for (int t = 0; t < SPOT_TYPE_COUNT; t++) {
+        for (uint32_t i = 0; i < lot.lotLayout().spotsPerFloor[t]; i++) {
+            occ.freeSpots[t] += lot.isFree(SpotId{uint16_t(floor), SpotType(t), i});
+        }
+    }
+    return occ;
+}
+
+void fill(ConcurrentSpotAllocator& lot, double ratio) {
+    mt19937 rng(3);
+    size_t target = size_t(lot.totalSpots() * ratio);
+    for (size_t i = 0; i < target; i++) {
+        int r = int(rng() % 10);
+        lot.park(r < 2 ? VehicleType::Motorcycle : r < 9 ? VehicleType::Car : VehicleType::Truck, int(i % 10));
+    }
+}
+
+void readCost(uint32_t perType) {
+    LotLayout layout{10, {perType, perType * 3, perType}};
+    ConcurrentSpotAllocator lot(layout);
+    fill(lot, 0.8);
+
+    const int floorReads = 10000000, snapshots = 1000000;
+    vector<FloorOccupancy> board(lot.shardCount());
+    uint64_t seen = 0;
+
+    auto t0 = Clock::now();
+    for (int i = 0; i < floorReads; i++) seen += lot.floorOccupancy(i % 10).freeSpots[1];
+    double floorNs = chrono::duration<double, nano>(Clock::now() - t0).count() / floorReads;
+
+    t0 = Clock::now();
+    for (int i = 0; i < snapshots; i++) {
+        lot.occupancySnapshot(board);
+        seen += board[i % 10].freeSpots[0];
+    }
+    double snapshotNs = chrono::duration<double, nano>(Clock::now() - t0).count() / snapshots;
+    sink = seen;
+
+    // Scan a few floors only; it is slow enough to measure once.
+    t0 = Clock::now();
+    bool matches = true;
+    for (int f = 0; f < 3; f++) {
+        FloorOccupancy scanned = scanFloor(lot, f), counted = lot.floorOccupancy(f);
+        for (int t = 0; t < SPOT_TYPE_COUNT; t++) matches &= scanned.freeSpots[t] == counted.freeSpots[t];
+    }
+    double scanUs = chrono::duration<double, micro>(Clock::now() - t0).count() / 3;
+
+    printf("%9zu spots | scan %10.1f us/floor | floorOccupancy %5.2f ns | snapshot (10 floors) %6.2f ns | counters %s\n",
+           lot.totalSpots(), scanUs, floorNs, snapshotNs, matches ? "match scan" : "WRONG");
+}
+
+void readWhileParking() {
+    LotLayout layout{10, {2000, 6000, 2000}};
+    ConcurrentSpotAllocator lot(layout);
+    fill(lot, 0.9);
+
+    atomic<bool> stop{false};
+    vector<thread> gates;
+    for (int g = 0; g < 2; g++) {
+        gates.emplace_back([&, g] {
+            mt19937 rng(g);
+            vector<SpotId> mine;
+            while (!stop.load(memory_order_relaxed)) {
+                if (mine.size() < 500 || rng() % 2) {
+                    if (auto s = lot.park(VehicleType::Car, g * 5)) mine.push_back(*s);
+                } else {
+                    size_t k = rng() % mine.size();
+                    lot.unpark(mine[k]);
+                    mine[k] = mine.back();
+                    mine.pop_back();
+                }
+            }
+            for (SpotId s : mine) lot.unpark(s);
+        });
+    }
+
+    vector<FloorOccupancy> board(lot.shardCount());
+    long reads = 0, impossible = 0;
+    auto start = Clock::now();
+    while (Clock::now() - start < chrono::milliseconds(500)) {
+        lot.occupancySnapshot(board);
+        for (const FloorOccupancy& f : board) {
+            for (int t = 0; t < SPOT_TYPE_COUNT; t++) impossible += f.freeSpots[t] > layout.spotsPerFloor[t];
+        }
+        reads++;
+    }
+    stop.store(true);
+    for (thread& t : gates) t.join();
+
+    printf("%ld snapshots while 2 gates park/unpark, impossible counts seen: %ld -> %s\n",
+           reads, impossible, impossible ? "FAIL" : "OK");
+}
+
+void snapshotWhileMoving() {
+    const int valets = 2;
+    LotLayout layout{16, {0, 64, 0}};
+    ConcurrentSpotAllocator lot(layout);
+    const size_t total = lot.totalSpots();
+
+    atomic<bool> stop{false};
+    atomic<long> moves{0};
+    atomic<int> parked{0};
+    vector<thread> movers;
+    for (int v = 0; v < valets; v++) {
+        movers.emplace_back([&] {
+            int floor = 0;
+            SpotId car = *lot.park(VehicleType::Car, floor);
+            parked.fetch_add(1);
+            while (!stop.load(memory_order_relaxed)) {
+                floor = layout.floors - 1 - floor;  // bottom <-> top
+                SpotId next = *lot.park(VehicleType::Car, floor);
+                lot.unpark(car);
+                car = next;
+                moves.fetch_add(1, memory_order_relaxed);
+            }
+            lot.unpark(car);
+        });
+    }
+    while (parked.load() < valets) this_thread::yield();  // every valet holds a car from here on
+
+    vector<FloorOccupancy> board(lot.shardCount());
+    long reads = 0, torn = 0;
+    auto start = Clock::now();
+    while (Clock::now() - start < chrono::milliseconds(500)) {
+        lot.occupancySnapshot(board);
+        size_t freeSpots = 0;
+        for (const FloorOccupancy& f : board) freeSpots += f.freeSpots[1];
+        size_t cars = total - freeSpots;
+        torn += cars < valets || cars > 2 * valets;
+        reads++;
+    }
+    stop.store(true);
+    for (thread& t : movers) t.join();
+
+    printf("%ld snapshots during %ld moves between floors, torn snapshots: %ld -> %s\n",
+           reads, moves.load(), torn, torn ? "FAIL" : "OK");
+}
+
+int main() {
+    cout << "=== Read cost as the lot grows (10 floors, 80% full) ===\n";
+    for (uint32_t perType : {1000u, 10000u, 100000u, 200000u}) readCost(perType);
+
+    cout << "\n=== Readers during traffic ===\n";
+    readWhileParking();
+    snapshotWhileMoving();
+    return 0;
+}
+
+/* ==========================================================
+   SAMPLE OUTPUT (1-core VM; numbers depend on the machine)
+   ----------------------------------------------------------
+   === Read cost as the lot grows (10 floors, 80% full) ===
+       50000 spots | scan       12.9 us/floor | floorOccupancy  1.93 ns | snapshot (10 floors)  24.49 ns | counters match scan
+      500000 spots | scan      153.6 us/floor | floorOccupancy  1.87 ns | snapshot (10 floors)  40.77 ns | counters match scan
+     5000000 spots | scan     1418.1 us/floor | floorOccupancy  2.05 ns | snapshot (10 floors)  30.82 ns | counters match scan
+    10000000 spots | scan     2848.8 us/floor | floorOccupancy  1.86 ns | snapshot (10 floors)  30.83 ns | counters match scan
+
+   === Readers during traffic ===
+   1368157 snapshots while 2 gates park/unpark, impossible counts seen: 0 -> OK
+   839938 snapshots during 4940191 moves between floors, torn snapshots: 0 -> OK
+
+   The scan grows with the lot (x200 from 50K to 10M spots); the
+   counter reads do not. With a single reader the counters sit in
+   cache; with gates on other cores each read of a recently changed
+   floor costs one cache-line transfer, still independent of lot size.
+   A snapshot reads every floor's write counts twice, so it costs
+   about twice a plain pass; with the old one-load-per-floor pass
+   the valet check saw a handful of torn snapshots per run.
+   ========================================================== */
@@ -0,0 +1,319 @@
+#include <vector>
+#include <queue>
+#include <random>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cerrno>
+#include <cstdlib>
+#include <string>
+#include <sys/resource.h>
+#include "concurrent_spot_allocator.h"
+#include "ticket_store.h"
+#include "fee_engine.h"
+#include "../../../03_Design_Patterns/common/instrumentation.h"
+using namespace std;
+
+/* ==========================================================
+   PARKING LOT TRAFFIC SIMULATOR
+   ----------------------------------------------------------
+   Plays one day of traffic against the real components:
+   ConcurrentSpotAllocator + TicketStore + FeeEngine.
+
+   - Arrivals are a Poisson process whose rate follows a daily
+     profile (morning and evening peaks), generated by thinning.
+   - Stay lengths are lognormal or exponential (configurable).
+   - Vehicle mix: motorcycles / cars / trucks (configurable).
+   - Each arrival uses a random gate; a gate's home floor is the
+     shard the allocator tries first.
+
+   Entry = park + issue ticket. Exit = plate lookup + fee + close
+   ticket + unpark. Both are timed one by one. Departures due
+   before midnight are processed even after the last arrival;
+   "still parked" is the lot at midnight.
+
+   Events run on one thread in simulated time, so a seed always
+   gives the same sequence of events. The "outcome digest" covers
+   every spot assigned and every fee charged: two runs with the same
+   options must print the same digest, whatever the timings were.
+
+   Build: g++ -std=c++20 -O2 parking_simulator.cpp   (Linux)
+   Run  : ./a.out [--floors=20] [--compact=10000] [--regular=30000]
+                  [--oversized=10000] [--gates=16] [--arrivals=5000000]
+                  [--stay=lognormal|exponential] [--stay-median=120]
+                  [--stay-sigma=1.0] [--mix=20,70,10] [--seed=1]
+   ========================================================== */
+
+using Clock = chrono::steady_clock;
+
+struct SimConfig {
+    int floors = 20;
+    uint32_t spotsPerFloor[SPOT_TYPE_COUNT] = {10000, 30000, 10000};
+    int gates = 16;
+    double arrivalsPerDay = 5000000;
+    bool lognormalStay = true;
+    double stayMedianMinutes = 120;   // exponential: this is the mean
+    double staySigma = 1.0;
+    int mixPercent[3] = {20, 70, 10}; // motorcycle, car, truck
+    uint64_t seed = 1;
+};
+
+// Relative arrival rate per hour of day: quiet night, peaks at 8-9 and 17-18.
+const double HOURLY_PROFILE[24] = {0.1, 0.1, 0.1, 0.1, 0.2, 0.4, 0.8, 1.6, 2.2, 1.8, 1.3, 1.2,
+                                   1.3, 1.2, 1.1, 1.2, 1.6, 2.0, 1.6, 1.1, 0.8, 0.5, 0.3, 0.2};
+
+// ---------------- Simulation -----------------
+struct Departure {
+    uint32_t second;
+    uint64_t plateNumber;
+    bool operator>(const Departure& o) const { return second > o.second; }
+};
+
+struct Plate {
+    char text[MAX_PLATE_LENGTH + 1];
+    string_view view() const { return string_view(text); }
+};
+
+Plate plateFor(uint64_t n) {
+    Plate p;
+    snprintf(p.text, sizeof p.text, "S%010llu", (unsigned long long)n);
+    return p;
+}
+
+uint64_t mixDigest(uint64_t h, uint64_t v) { return (h ^ v) * 0x100000001b3ULL; }
+
+long peakMemoryKb() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;  // KB on Linux
+}
+
+int run(const SimConfig& cfg) {
+    LotLayout layout{cfg.floors, {cfg.spotsPerFloor[0], cfg.spotsPerFloor[1], cfg.spotsPerFloor[2]}};
+    ConcurrentSpotAllocator lot(layout);
+    TicketStore tickets(lot.totalSpots());
+    FeeEngine fees({
+        {0, 7 * 60, {20, 40, 80}},
+        {7 * 60, 19 * 60, {60, 120, 240}},
+        {19 * 60, 24 * 60, {30, 60, 120}},
+    });
+
+    mt19937_64 rng(cfg.seed);
+    uniform_real_distribution<double> unit(0.0, 1.0);
+    lognormal_distribution<double> lognormalStay(log(cfg.stayMedianMinutes), cfg.staySigma);
+    exponential_distribution<double> exponentialStay(1.0 / cfg.stayMedianMinutes);
+
+    double profileSum = 0, profileMax = 0;
+    for (double r : HOURLY_PROFILE) {
+        profileSum += r;
+        profileMax = max(profileMax, r);
+    }
+    // Per-second rate at the busiest hour; thinning keeps the right share of candidates.
+    double peakRate = cfg.arrivalsPerDay / (profileSum * 3600.0) * profileMax;
+    exponential_distribution<double> gap(peakRate);
+
+    priority_queue<Departure, vector<Departure>, greater<Departure>> departures;
+    instrumentation::LatencyHistogram entryLatency, exitLatency;  // bucket upper ends, exact max
+    uint64_t arrivals = 0, turnedAway = 0, exits = 0, digest = 0xcbf29ce484222325ULL;
+    uint64_t revenueCents = 0;
+    size_t parkedNow = 0, peakParked = 0;
+
+    auto exitOne = [&](const Departure& d) {
+        Plate plate = plateFor(d.plateNumber);
+        auto t0 = Clock::now();
+        const Ticket* ticket = tickets.findByPlate(plate.view());    // exit camera
+        Ticket t = *tickets.close(ticket->id);
+        int32_t cents = fees.fee(t.vehicle, t.entryMinute, d.second / 60);
+        lot.unpark(t.spot);
+        exitLatency.record(uint64_t(chrono::duration<double, nano>(Clock::now() - t0).count()));
+
+        revenueCents += cents;
+        digest = mixDigest(digest, uint64_t(cents));
+        exits++;
+        parkedNow--;
+    };
+
+    const double daySeconds = 24 * 3600;
+    double now = 0;
+    auto wallStart = Clock::now();
+    while (true) {
+        now += gap(rng);
+        if (now >= daySeconds) break;
+        if (unit(rng) * profileMax > HOURLY_PROFILE[int(now / 3600)]) continue;  // thinned out
+
+        uint32_t second = uint32_t(now);
+        while (!departures.empty() && departures.top().second <= second) {
+            exitOne(departures.top());
+            departures.pop();
+        }
+
+        // Draw everything random before timing so the latency is only the system's.
+        int r = int(unit(rng) * 100);
+        VehicleType vehicle = r < cfg.mixPercent[0] ? VehicleType::Motorcycle
+                            : r < cfg.mixPercent[0] + cfg.mixPercent[1] ? VehicleType::Car : VehicleType::Truck;
+        int gate = int(unit(rng) * cfg.gates);
+        double stayMinutes = cfg.lognormalStay ? lognormalStay(rng) : exponentialStay(rng);
+        uint32_t leaveAt = second + 60 + uint32_t(min(stayMinutes, 7.0 * 24 * 60) * 60);
+        uint64_t plateNumber = arrivals++;
+        Plate plate = plateFor(plateNumber);
+
+        auto t0 = Clock::now();
+        auto spot = lot.park(vehicle, gate * cfg.floors / cfg.gates);
+        if (spot) tickets.issue(plate.view(), vehicle, *spot, second / 60);
+        entryLatency.record(uint64_t(chrono::duration<double, nano>(Clock::now() - t0).count()));
+
+        if (!spot) {
+            turnedAway++;
+            digest = mixDigest(digest, ~uint64_t(0));
+            continue;
+        }
+        digest = mixDigest(digest, lot.flatIndex(*spot));
+        departures.push(Departure{leaveAt, plateNumber});
+        peakParked = max(peakParked, ++parkedNow);
+    }
+    // Cars due out before midnight but after the last arrival.
+    while (!departures.empty() && departures.top().second < daySeconds) {
+        exitOne(departures.top());
+        departures.pop();
+    }
+    double wallSecs = chrono::duration<double>(Clock::now() - wallStart).count();
+
+    printf("=== Lot: %d floors x (%u, %u, %u) = %zu spots, %d gates, seed %llu ===\n",
+           cfg.floors, cfg.spotsPerFloor[0], cfg.spotsPerFloor[1], cfg.spotsPerFloor[2],
+           lot.totalSpots(), cfg.gates, (unsigned long long)cfg.seed);
+    if (cfg.lognormalStay) printf("stay: lognormal, median %.0f min, sigma %.2f", cfg.stayMedianMinutes, cfg.staySigma);
+    else printf("stay: exponential, mean %.0f min", cfg.stayMedianMinutes);
+    printf(" | mix %d/%d/%d\n", cfg.mixPercent[0], cfg.mixPercent[1], cfg.mixPercent[2]);
+    printf("arrivals %llu, turned away %llu (%.3f%%), exits %llu, still parked %zu, peak occupancy %.1f%%\n",
+           (unsigned long long)arrivals, (unsigned long long)turnedAway, 100.0 * turnedAway / max<uint64_t>(arrivals, 1),
+           (unsigned long long)exits, parkedNow, 100.0 * peakParked / lot.totalSpots());
+    printf("entry latency: p50 %5llu ns, p99 %6llu ns, max %7llu ns\n", (unsigned long long)entryLatency.percentile(0.50),
+           (unsigned long long)entryLatency.percentile(0.99), (unsigned long long)entryLatency.max());
+    printf("exit  latency: p50 %5llu ns, p99 %6llu ns, max %7llu ns\n", (unsigned long long)exitLatency.percentile(0.50),
+           (unsigned long long)exitLatency.percentile(0.99), (unsigned long long)exitLatency.max());
+    printf("revenue %.2f | simulated a day in %.2f s | peak memory %.1f MB\n",
+           revenueCents / 100.0, wallSecs, peakMemoryKb() / 1024.0);
+    printf("outcome digest %016llx\n", (unsigned long long)digest);
+    return 0;
+}
+
+// ---------------- Options -----------------
+// The whole value must be a number in [lo, hi]: "abc", "12x" and overflow are rejected.
+bool parseInteger(const char* v, long long lo, long long hi, long long& out) {
+    char* end;
+    errno = 0;
+    long long n = strtoll(v, &end, 10);
+    if (end == v || *end != '\0' || errno == ERANGE || n < lo || n > hi) return false;
+    out = n;
+    return true;
+}
+
+bool parseNumber(const char* v, double& out) {
+    char* end;
+    errno = 0;
+    double x = strtod(v, &end);
+    if (end == v || *end != '\0' || errno == ERANGE || !isfinite(x)) return false;
+    out = x;
+    return true;
+}
+
+bool parseOption(SimConfig& cfg, const string& arg) {
+    size_t eq = arg.find('=');
+    if (arg.rfind("--", 0) != 0 || eq == string::npos) return false;
+    string key = arg.substr(2, eq - 2), value = arg.substr(eq + 1);
+    const char* v = value.c_str();
+    long long n;
+
+    if (key == "floors") {
+        if (!parseInteger(v, 1, UINT16_MAX, n)) return false;
+        cfg.floors = int(n);
+    } else if (key == "compact" || key == "regular" || key == "oversized") {
+        if (!parseInteger(v, 0, UINT32_MAX, n)) return false;
+        cfg.spotsPerFloor[key == "compact" ? 0 : key == "regular" ? 1 : 2] = uint32_t(n);
+    } else if (key == "gates") {
+        if (!parseInteger(v, 1, INT32_MAX, n)) return false;
+        cfg.gates = int(n);
+    } else if (key == "seed") {
+        if (!parseInteger(v, 0, INT64_MAX, n)) return false;
+        cfg.seed = uint64_t(n);
+    } else if (key == "arrivals") {
+        if (!parseNumber(v, cfg.arrivalsPerDay)) return false;
+    } else if (key == "stay-median") {
+        if (!parseNumber(v, cfg.stayMedianMinutes)) return false;
+    } else if (key == "stay-sigma") {
+        if (!parseNumber(v, cfg.staySigma)) return false;
+    } else if (key == "stay") {
+        if (value != "lognormal" && value != "exponential") return false;
+        cfg.lognormalStay = value == "lognormal";
+    } else if (key == "mix") {
+        int used = 0;
+        if (sscanf(v, "%d,%d,%d%n", &cfg.mixPercent[0], &cfg.mixPercent[1], &cfg.mixPercent[2], &used) != 3) return false;
+        if (v[used] != '\0') return false;
+        for (int p : cfg.mixPercent)
+            if (p < 0) return false;
+        if (cfg.mixPercent[0] + cfg.mixPercent[1] + cfg.mixPercent[2] != 100) return false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    SimConfig cfg;
+    for (int i = 1; i < argc; i++) {
+        if (!parseOption(cfg, argv[i])) {
+            fprintf(stderr, "bad option: %s (see the header of parking_simulator.cpp)\n", argv[i]);
+            return 1;
+        }
+    }
+    if (cfg.floors <= 0 || cfg.gates <= 0 || cfg.arrivalsPerDay <= 0 || cfg.stayMedianMinutes <= 0) {
+        fprintf(stderr, "floors, gates, arrivals and stay-median must be positive\n");
+        return 1;
+    }
+    try {
+        return run(cfg);
+    } catch (const exception& e) {
+        fprintf(stderr, "error: %s\n", e.what());
+        return 1;
+    }
+}
+
+/* ==========================================================
+   SAMPLE OUTPUT (1-core VM; latencies depend on the machine,
+   everything else depends only on the options)
+   ----------------------------------------------------------
+   $ ./a.out
+   === Lot: 20 floors x (10000, 30000, 10000) = 1000000 spots, 16 gates, seed 1 ===
+   stay: lognormal, median 120 min, sigma 1.00 | mix 20/70/10
+   arrivals 4999326, turned away 73626 (1.473%), exits 4461894, still parked 463806, peak occupancy 100.0%
+   entry latency: p50   367 ns, p99    735 ns, max 2081951 ns
+   exit  latency: p50   783 ns, p99   1279 ns, max 4142155 ns
+   revenue 11977365.62 | simulated a day in 13.15 s | peak memory 90.9 MB
+   outcome digest 7b9fb206740d160e
+
+   $ ./a.out --floors=100 --compact=20000 --regular=60000 --oversized=20000 --arrivals=30000000 --gates=64
+   === Lot: 100 floors x (20000, 60000, 20000) = 10000000 spots, 64 gates, seed 1 ===
+   arrivals 29999392, turned away 0 (0.000%), exits 27151719, still parked 2847673, peak occupancy 63.5%
+   entry latency: p50   391 ns, p99    799 ns, max 5391154 ns
+   exit  latency: p50   991 ns, p99   1567 ns, max 6221346 ns
+   revenue 72590812.04 | simulated a day in 94.46 s | peak memory 600.2 MB
+
+   $ ./a.out --floors=1 --compact=100 --regular=100 --oversized=100 --gates=1 --arrivals=200
+   === Lot: 1 floors x (100, 100, 100) = 300 spots, 1 gates, seed 1 ===
+   stay: lognormal, median 120 min, sigma 1.00 | mix 20/70/10
+   arrivals 195, turned away 0 (0.000%), exits 168, still parked 27, peak occupancy 17.7%
+   entry latency: p50   151 ns, p99    591 ns, max 1518876 ns
+   exit  latency: p50   199 ns, p99    511 ns, max    3624 ns
+   revenue 436.47 | simulated a day in 0.00 s | peak memory 6.0 MB
+   outcome digest 19737727688e2ef8
+
+   - The default lot is too small for the evening peak: it fills up
+     and ~1.5% of drivers are turned away. Sizing = raise the spots
+     until the failure rate is acceptable at the expected arrivals.
+   - Exit costs about twice an entry: plate lookup, ticket removal
+     from two indexes, fee and unpark each touch cold memory.
+   - With light traffic the last arrival can be hours before
+     midnight; the cars that leave after it still count as exits.
+   - Max latencies are the OS descheduling the process, not the
+     data structures; compare p99 between runs, not max.
+   ========================================================== */
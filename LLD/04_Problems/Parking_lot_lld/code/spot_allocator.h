@@ -0,0 +1,215 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+/* ==========================================================
+   SPOT ALLOCATOR - O(1) parking spot assignment
+   ----------------------------------------------------------
+   Every (floor, spot type) keeps a bitset of FREE spots
+   (bit = 1 means free). Bits are ordered by distance from the
+   entrance, so "nearest free spot" = lowest set bit.
+
+   A flat bitset would need a scan to find that bit. Here each
+   bitset is hierarchical:
+     level 0 : one bit per spot
+     level 1 : one bit per level-0 word  (set = that word has a free spot)
+     level 2 : one bit per level-1 word  ... up to a single word
+   Finding the first free spot is one count-trailing-zeros per
+   level (4 levels cover 16M spots). Parking and unparking touch
+   one word per level at most.
+
+   A second hierarchical bitset per spot type tracks which floors
+   still have a free spot, so picking the nearest floor is O(1)
+   as well.
+   ========================================================== */
+
+enum class VehicleType : uint8_t { Motorcycle, Car, Truck };
+enum class SpotType : uint8_t { Compact, Regular, Oversized };
+
+constexpr int SPOT_TYPE_COUNT = 3;
+
+// Spot types a vehicle fits in, smallest first. A motorcycle may use any
+// spot, a car needs at least a regular one, a truck needs an oversized one.
+struct SpotChoices {
+    SpotType types[SPOT_TYPE_COUNT];
+    int count;
+};
+
+inline SpotChoices spotChoicesFor(VehicleType v) {
+    switch (v) {
+        case VehicleType::Motorcycle: return {{SpotType::Compact, SpotType::Regular, SpotType::Oversized}, 3};
+        case VehicleType::Car:        return {{SpotType::Regular, SpotType::Oversized}, 2};
+        case VehicleType::Truck:      return {{SpotType::Oversized}, 1};
+    }
+    return {{}, 0};
+}
+
+struct SpotId {
+    uint16_t floor;
+    SpotType type;
+    uint32_t index;  // position on the floor within its type, 0 = nearest
+
+    bool operator==(const SpotId&) const = default;
+};
+
+// ---------------- Hierarchical bitset -----------------
+class HierarchicalBitset {
+private:
+    // levels[0] has one bit per item; levels[k] has one bit per word of levels[k-1].
+    std::vector<std::vector<uint64_t>> levels;
+    size_t bitCount;
+
+public:
+    static constexpr size_t npos = SIZE_MAX;
+
+    explicit HierarchicalBitset(size_t n = 0, bool allSet = false) : bitCount(n) {
+        size_t items = n;
+        do {
+            size_t words = (items + 63) / 64;
+            if (words == 0) words = 1;
+            levels.emplace_back(words, 0);
+            items = words;
+        } while (items > 1);
+
+        if (allSet) fill();
+    }
+
+    // Sets every bit, building each summary level from the one below it.
+    void fill() {
+        std::vector<uint64_t>& leaf = levels[0];
+        for (size_t w = 0; w < leaf.size(); w++) {
+            size_t remaining = bitCount - std::min(bitCount, w * 64);
+            leaf[w] = remaining >= 64 ? ~uint64_t(0) : (uint64_t(1) << remaining) - 1;
+        }
+        for (size_t l = 1; l < levels.size(); l++) {
+            std::fill(levels[l].begin(), levels[l].end(), 0);
+            for (size_t w = 0; w < levels[l - 1].size(); w++) {
+                if (levels[l - 1][w]) levels[l][w >> 6] |= uint64_t(1) << (w & 63);
+            }
+        }
+    }
+
+    size_t size() const { return bitCount; }
+    bool any() const { return levels.back()[0] != 0; }
+
+    bool test(size_t i) const { return (levels[0][i >> 6] >> (i & 63)) & 1; }
+
+    void set(size_t i) {
+        for (auto& level : levels) {
+            uint64_t& word = level[i >> 6];
+            bool wasEmpty = word == 0;
+            word |= uint64_t(1) << (i & 63);
+            if (!wasEmpty) return;  // parents already know this word is non-empty
+            i >>= 6;
+        }
+    }
+
+    void reset(size_t i) {
+        for (auto& level : levels) {
+            uint64_t& word = level[i >> 6];
+            word &= ~(uint64_t(1) << (i & 63));
+            if (word != 0) return;  // word still has bits: parents unchanged
+            i >>= 6;
+        }
+    }
+
+    // Lowest set bit, or npos.
+    size_t findFirst() const {
+        size_t idx = 0;
+        for (size_t l = levels.size(); l-- > 0;) {
+            uint64_t word = levels[l][idx];
+            if (word == 0) return npos;
+            idx = idx * 64 + std::countr_zero(word);
+        }
+        return idx;
+    }
+
+    size_t memoryBytes() const {
+        size_t bytes = 0;
+        for (const auto& level : levels) bytes += level.size() * sizeof(uint64_t);
+        return bytes;
+    }
+};
+
+// ---------------- Parking lot engine -----------------
+
+struct LotLayout {
+    int floors;
+    uint32_t spotsPerFloor[SPOT_TYPE_COUNT];  // compact, regular, oversized
+};
+
+class SpotAllocator {
+private:
+    LotLayout layout;
+    std::vector<HierarchicalBitset> freeSpots;                 // [floor * 3 + type]
+    HierarchicalBitset floorsWithFree[SPOT_TYPE_COUNT];        // per type: bit = floor
+    size_t freeCount[SPOT_TYPE_COUNT] = {};
+
+    HierarchicalBitset& spots(int floor, SpotType t) { return freeSpots[floor * SPOT_TYPE_COUNT + int(t)]; }
+
+public:
+    explicit SpotAllocator(const LotLayout& l) : layout(l) {
+        if (l.floors <= 0 || l.floors > UINT16_MAX) throw std::invalid_argument("bad floor count");
+        freeSpots.reserve(size_t(l.floors) * SPOT_TYPE_COUNT);
+        for (int f = 0; f < l.floors; f++) {
+            for (int t = 0; t < SPOT_TYPE_COUNT; t++) freeSpots.emplace_back(l.spotsPerFloor[t], true);
+        }
+        for (int t = 0; t < SPOT_TYPE_COUNT; t++) {
+            floorsWithFree[t] = HierarchicalBitset(l.floors, l.spotsPerFloor[t] > 0);
+            freeCount[t] = size_t(l.floors) * l.spotsPerFloor[t];
+        }
+    }
+
+    // Smallest fitting spot type first, then nearest floor, then nearest spot.
+    std::optional<SpotId> park(VehicleType v) {
+        SpotChoices choices = spotChoicesFor(v);
+        for (int c = 0; c < choices.count; c++) {
+            SpotType t = choices.types[c];
+            size_t floor = floorsWithFree[int(t)].findFirst();
+            if (floor == HierarchicalBitset::npos) continue;
+
+            HierarchicalBitset& bits = spots(int(floor), t);
+            size_t index = bits.findFirst();
+            bits.reset(index);
+            if (!bits.any()) floorsWithFree[int(t)].reset(floor);
+            freeCount[int(t)]--;
+            return SpotId{uint16_t(floor), t, uint32_t(index)};
+        }
+        return std::nullopt;
+    }
+
+    // Returns false if the spot does not exist or is already free.
+    bool unpark(SpotId id) {
+        if (id.floor >= layout.floors || id.index >= layout.spotsPerFloor[int(id.type)]) return false;
+        HierarchicalBitset& bits = spots(id.floor, id.type);
+        if (bits.test(id.index)) return false;
+
+        bool floorWasFull = !bits.any();
+        bits.set(id.index);
+        if (floorWasFull) floorsWithFree[int(id.type)].set(id.floor);
+        freeCount[int(id.type)]++;
+        return true;
+    }
+
+    bool isFree(SpotId id) const { return freeSpots[id.floor * SPOT_TYPE_COUNT + int(id.type)].test(id.index); }
+    size_t freeSpotsOfType(SpotType t) const { return freeCount[int(t)]; }
+    const LotLayout& lotLayout() const { return layout; }
+
+    size_t totalSpots() const {
+        size_t n = 0;
+        for (int t = 0; t < SPOT_TYPE_COUNT; t++) n += size_t(layout.floors) * layout.spotsPerFloor[t];
+        return n;
+    }
+
+    size_t memoryBytes() const {
+        size_t bytes = 0;
+        for (const auto& b : freeSpots) bytes += b.memoryBytes();
+        return bytes;
+    }
+};
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "spot_allocator.h"
+
+/* ==========================================================
+   TICKET STORE - compact active tickets, O(1) exit lookup
+   ----------------------------------------------------------
+   - Every ticket is one fixed 40-byte record (plate stored
+     inline, no std::string), kept in an arena of big chunks.
+     A closed ticket's slot goes on an intrusive free list and
+     is reused by the next entry, so there is no heap
+     allocation per ticket.
+   - Two open-addressing hash indexes (linear probing) map
+     ticket ID -> slot and plate -> slot. An index entry is
+     8 bytes: the slot number and 32 bits of the key's hash.
+     The stored hash skips most record reads on a miss and lets
+     the table grow without touching the records.
+   - Deleting uses backward shifting instead of tombstones, so
+     lookups stay short however many tickets come and go.
+   ========================================================== */
+
+constexpr size_t MAX_PLATE_LENGTH = 11;
+
+struct Ticket {
+    uint64_t id;
+    SpotId spot;
+    uint32_t entryMinute;                  // minutes since the lot opened
+    char plate[MAX_PLATE_LENGTH + 1];      // zero padded
+    VehicleType vehicle;
+
+    std::string_view plateView() const { return std::string_view(plate, strnlen(plate, sizeof plate)); }
+};
+
+static_assert(sizeof(Ticket) == 40, "ticket record should stay one fixed 40-byte slot");
+
+// ---------------- Open-addressing index -----------------
+// Stores slot numbers only; the caller says how to compare a key with a slot.
+class SlotIndex {
+private:
+    struct Entry {
+        uint32_t slot;
+        uint32_t hash;
+    };
+    static constexpr uint32_t EMPTY = UINT32_MAX;
+
+    std::vector<Entry> entries;
+    size_t mask = 0;
+    size_t count = 0;
+
+    void grow() {
+        std::vector<Entry> old = std::move(entries);
+        entries.assign(old.size() * 2, Entry{EMPTY, 0});
+        mask = entries.size() - 1;
+        for (const Entry& e : old) {
+            if (e.slot == EMPTY) continue;
+            size_t i = e.hash & mask;
+            while (entries[i].slot != EMPTY) i = (i + 1) & mask;
+            entries[i] = e;
+        }
+    }
+
+public:
+    explicit SlotIndex(size_t expected = 16) {
+        size_t capacity = 16;
+        while (capacity * 7 / 10 < expected) capacity *= 2;
+        entries.assign(capacity, Entry{EMPTY, 0});
+        mask = capacity - 1;
+    }
+
+    template <typename Matches>
+    uint32_t find(uint32_t hash, Matches matches) const {
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            const Entry& e = entries[i];
+            if (e.slot == EMPTY) return EMPTY;
+            if (e.hash == hash && matches(e.slot)) return e.slot;
+        }
+    }
+
+    // The caller has checked that the key is not present yet.
+    void insert(uint32_t hash, uint32_t slot) {
+        if ((count + 1) * 10 > entries.size() * 7) grow();  // keep load <= 70%
+        size_t i = hash & mask;
+        while (entries[i].slot != EMPTY) i = (i + 1) & mask;
+        entries[i] = Entry{slot, hash};
+        count++;
+    }
+
+    void erase(uint32_t hash, uint32_t slot) {
+        size_t i = hash & mask;
+        while (entries[i].slot != slot) {
+            if (entries[i].slot == EMPTY) return;
+            i = (i + 1) & mask;
+        }
+        // Backward shift: pull later entries of the probe run into the hole
+        // unless that would move one in front of its home position.
+        for (size_t j = (i + 1) & mask; entries[j].slot != EMPTY; j = (j + 1) & mask) {
+            size_t home = entries[j].hash & mask;
+            if (((j - home) & mask) >= ((j - i) & mask)) {
+                entries[i] = entries[j];
+                i = j;
+            }
+        }
+        entries[i] = Entry{EMPTY, 0};
+        count--;
+    }
+
+    static constexpr uint32_t notFound() { return EMPTY; }
+    size_t memoryBytes() const { return entries.capacity() * sizeof(Entry); }
+};
+
+// ---------------- Ticket store -----------------
+class TicketStore {
+private:
+    static constexpr size_t CHUNK_SLOTS = 1 << 16;
+
+    // A free slot reuses its record bytes as the free-list link.
+    union Slot {
+        Ticket ticket;
+        uint32_t nextFree;
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> chunks;  // chunks never move, so Ticket* stays valid
+    uint32_t usedSlots = 0;
+    uint32_t freeHead = SlotIndex::notFound();
+    size_t active = 0;
+    uint64_t nextId = 1;
+
+    SlotIndex byId;
+    SlotIndex byPlate;
+
+    Slot& slotAt(uint32_t s) { return chunks[s / CHUNK_SLOTS][s % CHUNK_SLOTS]; }
+    const Slot& slotAt(uint32_t s) const { return chunks[s / CHUNK_SLOTS][s % CHUNK_SLOTS]; }
+
+    static uint32_t hashId(uint64_t id) {
+        // splitmix64 finalizer: sequential IDs spread over the whole table
+        id += 0x9e3779b97f4a7c15ULL;
+        id = (id ^ (id >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        id = (id ^ (id >> 27)) * 0x94d049bb133111ebULL;
+        return uint32_t(id ^ (id >> 31));
+    }
+
+    static uint32_t hashPlate(std::string_view plate) {
+        uint64_t h = 0xcbf29ce484222325ULL;  // FNV-1a
+        for (char c : plate) h = (h ^ uint8_t(c)) * 0x100000001b3ULL;
+        return uint32_t(h ^ (h >> 32));
+    }
+
+    uint32_t allocSlot() {
+        if (freeHead != SlotIndex::notFound()) {
+            uint32_t s = freeHead;
+            freeHead = slotAt(s).nextFree;
+            return s;
+        }
+        if (usedSlots == SlotIndex::notFound()) throw std::length_error("ticket store is full");
+        if (usedSlots % CHUNK_SLOTS == 0) chunks.push_back(std::make_unique<Slot[]>(CHUNK_SLOTS));
+        return usedSlots++;
+    }
+
+    uint32_t slotOfId(uint64_t id) const {
+        return byId.find(hashId(id), [&](uint32_t s) { return slotAt(s).ticket.id == id; });
+    }
+
+    uint32_t slotOfPlate(std::string_view plate) const {
+        return byPlate.find(hashPlate(plate), [&](uint32_t s) { return slotAt(s).ticket.plateView() == plate; });
+    }
+
+public:
+    explicit TicketStore(size_t expectedTickets = 1024) : byId(expectedTickets), byPlate(expectedTickets) {
+        chunks.reserve(expectedTickets / CHUNK_SLOTS + 1);
+    }
+
+    // Issues a ticket at entry. nullopt if this plate already has an active ticket.
+    std::optional<Ticket> issue(std::string_view plate, VehicleType vehicle, SpotId spot, uint32_t entryMinute) {
+        if (plate.empty() || plate.size() > MAX_PLATE_LENGTH) throw std::invalid_argument("bad license plate");
+        if (slotOfPlate(plate) != SlotIndex::notFound()) return std::nullopt;
+
+        uint32_t s = allocSlot();
+        Ticket& t = slotAt(s).ticket;
+        t = Ticket{};
+        t.id = nextId++;
+        t.spot = spot;
+        t.entryMinute = entryMinute;
+        t.vehicle = vehicle;
+        memcpy(t.plate, plate.data(), plate.size());
+
+        byId.insert(hashId(t.id), s);
+        byPlate.insert(hashPlate(plate), s);
+        active++;
+        return t;
+    }
+
+    // Pointers stay valid until that ticket is closed.
+    const Ticket* findById(uint64_t id) const {
+        uint32_t s = slotOfId(id);
+        return s == SlotIndex::notFound() ? nullptr : &slotAt(s).ticket;
+    }
+
+    const Ticket* findByPlate(std::string_view plate) const {
+        uint32_t s = slotOfPlate(plate);
+        return s == SlotIndex::notFound() ? nullptr : &slotAt(s).ticket;
+    }
+
+    // Closes the ticket at exit and returns it; nullopt if there is no such active ticket.
+    std::optional<Ticket> close(uint64_t id) {
+        uint32_t s = slotOfId(id);
+        if (s == SlotIndex::notFound()) return std::nullopt;
+
+        Ticket t = slotAt(s).ticket;
+        byId.erase(hashId(id), s);
+        byPlate.erase(hashPlate(t.plateView()), s);
+        slotAt(s).nextFree = freeHead;
+        freeHead = s;
+        active--;
+        return t;
+    }
+
+    size_t size() const { return active; }
+
+    size_t memoryBytes() const {
+        return chunks.size() * CHUNK_SLOTS * sizeof(Slot) + chunks.capacity() * sizeof(chunks[0])
+             + byId.memoryBytes() + byPlate.memoryBytes();
+    }
+};
@@ -0,0 +1,221 @@
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <fstream>
+#include <cstdio>
+#include <unistd.h>
+#include "ticket_store.h"
+using namespace std;
+
+/* ==========================================================
+   TICKET STORE BENCHMARK - 10M active tickets
+   ----------------------------------------------------------
+   Compares TicketStore with the textbook version: one heap
+   object per ticket with a std::string plate, plus two
+   unordered_maps (id -> ticket, plate -> id).
+
+   Reports memory per active ticket (resident memory actually
+   used, read from /proc) and the exit-gate lookups:
+     by plate : number-plate camera at the exit
+     by id    : ticket scanned at the exit
+   plus steady churn (one exit + one entry).
+
+   Build: g++ -std=c++20 -O2 ticket_store_benchmark.cpp   (Linux)
+   ========================================================== */
+
+using Clock = chrono::steady_clock;
+
+// Resident memory of this process in bytes.
+size_t residentBytes() {
+    ifstream statm("/proc/self/statm");
+    size_t pages = 0, resident = 0;
+    statm >> pages >> resident;
+    return resident * size_t(sysconf(_SC_PAGESIZE));
+}
+
+// Unique plate for every i, e.g. "KA07QX0123".
+struct Plate {
+    char text[MAX_PLATE_LENGTH + 1];
+    string_view view() const { return string_view(text); }
+};
+
+Plate plateFor(size_t i) {
+    Plate p;
+    snprintf(p.text, sizeof p.text, "KA%02zu%c%c%04zu", (i / 10000 / 676) % 100,
+             char('A' + (i / 10000 / 26) % 26), char('A' + (i / 10000) % 26), i % 10000);
+    return p;
+}
+
+SpotId spotFor(size_t i) { return SpotId{uint16_t(i % 20), SpotType::Regular, uint32_t(i / 20)}; }
+
+// --- Textbook baseline ---
+struct TicketObject {
+    uint64_t id;
+    string plate;
+    VehicleType vehicle;
+    SpotId spot;
+    uint32_t entryMinute;
+};
+
+struct NaiveTicketStore {
+    unordered_map<uint64_t, unique_ptr<TicketObject>> byId;
+    unordered_map<string, uint64_t> byPlate;
+    uint64_t nextId = 1;
+
+    explicit NaiveTicketStore(size_t expected) {
+        byId.reserve(expected);
+        byPlate.reserve(expected);
+    }
+
+    uint64_t issue(string_view plate, VehicleType v, SpotId spot, uint32_t minute) {
+        uint64_t id = nextId++;
+        byId.emplace(id, make_unique<TicketObject>(TicketObject{id, string(plate), v, spot, minute}));
+        byPlate.emplace(string(plate), id);
+        return id;
+    }
+    const TicketObject* findById(uint64_t id) const {
+        auto it = byId.find(id);
+        return it == byId.end() ? nullptr : it->second.get();
+    }
+    const TicketObject* findByPlate(const string& plate) const {
+        auto it = byPlate.find(plate);
+        return it == byPlate.end() ? nullptr : findById(it->second);
+    }
+    void close(uint64_t id) {
+        auto it = byId.find(id);
+        byPlate.erase(it->second->plate);
+        byId.erase(it);
+    }
+};
+
+struct Result {
+    double bytesPerTicket;
+    double plateNs, idNs, churnNs;
+    double plateP50, plateP99;
+};
+
+double nsPerOp(Clock::time_point start, size_t ops) {
+    return chrono::duration<double, nano>(Clock::now() - start).count() / ops;
+}
+
+// Runs the same workload on either store; the lambdas hide the API differences.
+template <typename Store, typename Issue, typename ByPlate, typename ById, typename Close>
+Result run(size_t n, Issue issue, ByPlate byPlate, ById byId, Close close) {
+    const size_t lookups = 2000000;
+    mt19937_64 rng(7);
+
+    // Queries are prepared before measuring memory so they do not count.
+    vector<size_t> picks(lookups);
+    for (size_t& k : picks) k = rng() % n;
+    vector<Plate> queryPlates(lookups);
+    for (size_t q = 0; q < lookups; q++) queryPlates[q] = plateFor(picks[q]);
+    vector<uint64_t> ids(n);   // id of the ticket holding plate i
+    vector<size_t> plateOf(n); // plate number held by ticket slot i (for churn)
+
+    size_t before = residentBytes();
+    Store store(n);
+    for (size_t i = 0; i < n; i++) {
+        ids[i] = issue(store, plateFor(i).view(), VehicleType::Car, spotFor(i), uint32_t(i % 1440));
+        plateOf[i] = i;
+    }
+    Result r{};
+    r.bytesPerTicket = double(residentBytes() - before) / n;
+
+    long found = 0;
+    auto start = Clock::now();
+    for (size_t q = 0; q < lookups; q++) found += byPlate(store, queryPlates[q].view()) != nullptr;
+    r.plateNs = nsPerOp(start, lookups);
+
+    start = Clock::now();
+    for (size_t q = 0; q < lookups; q++) found += byId(store, ids[picks[q]]) != nullptr;
+    r.idNs = nsPerOp(start, lookups);
+
+    // Per-lookup timing for percentiles (includes ~20 ns of clock overhead)
+    vector<double> samples(200000);
+    for (size_t q = 0; q < samples.size(); q++) {
+        auto t0 = Clock::now();
+        found += byPlate(store, queryPlates[q].view()) != nullptr;
+        samples[q] = chrono::duration<double, nano>(Clock::now() - t0).count();
+    }
+    sort(samples.begin(), samples.end());
+    r.plateP50 = samples[samples.size() / 2];
+    r.plateP99 = samples[samples.size() * 99 / 100];
+
+    // Churn: a random car leaves, a new one (new plate) enters
+    size_t nextPlate = n;
+    start = Clock::now();
+    for (size_t q = 0; q < lookups; q++) {
+        size_t k = picks[q];
+        close(store, ids[k]);
+        ids[k] = issue(store, plateFor(nextPlate).view(), VehicleType::Car, spotFor(k), uint32_t(q % 1440));
+        plateOf[k] = nextPlate++;
+    }
+    r.churnNs = nsPerOp(start, lookups);
+
+    // Every active ticket must still be reachable both ways
+    for (size_t k = 0; k < n; k += 97) {
+        auto* t = byId(store, ids[k]);
+        if (!t || byPlate(store, plateFor(plateOf[k]).view()) != t) found = -1;
+    }
+    if (found < 0) cout << "CHECK FAILED\n";
+    return r;
+}
+
+void print(const char* name, const Result& r) {
+    printf("%-12s %6.1f B/ticket | by plate %6.1f ns (p50 %5.0f, p99 %5.0f) | by id %6.1f ns | exit+entry %6.1f ns\n",
+           name, r.bytesPerTicket, r.plateNs, r.plateP50, r.plateP99, r.idNs, r.churnNs);
+}
+
+int main() {
+    const size_t N = 10000000;
+    cout << "=== " << N << " active tickets ===\n";
+    cout << "sizeof(Ticket) = " << sizeof(Ticket) << " bytes\n";
+
+    {
+        Result r = run<TicketStore>(
+            N,
+            [](TicketStore& s, string_view p, VehicleType v, SpotId spot, uint32_t m) { return s.issue(p, v, spot, m)->id; },
+            [](TicketStore& s, string_view p) { return s.findByPlate(p); },
+            [](TicketStore& s, uint64_t id) { return s.findById(id); },
+            [](TicketStore& s, uint64_t id) { s.close(id); });
+        print("TicketStore", r);
+    }
+    {
+        // unordered_map wants a std::string key; building it is part of the lookup cost.
+        Result r = run<NaiveTicketStore>(
+            N,
+            [](NaiveTicketStore& s, string_view p, VehicleType v, SpotId spot, uint32_t m) { return s.issue(p, v, spot, m); },
+            [](NaiveTicketStore& s, string_view p) { return s.findByPlate(string(p)); },
+            [](NaiveTicketStore& s, uint64_t id) { return s.findById(id); },
+            [](NaiveTicketStore& s, uint64_t id) { s.close(id); });
+        print("Textbook", r);
+    }
+    return 0;
+}
+
+/* ==========================================================
+   SAMPLE OUTPUT (numbers depend on the machine)
+   ----------------------------------------------------------
+   === 10000000 active tickets ===
+   sizeof(Ticket) = 40 bytes
+   TicketStore    67.0 B/ticket | by plate  222.4 ns (p50   478, p99   868) | by id   91.2 ns | exit+entry 1547.7 ns
+   Textbook      176.6 B/ticket | by plate 1192.1 ns (p50  1262, p99  2367) | by id   83.0 ns | exit+entry 2497.0 ns
+
+   Takeaways:
+   - 67 B/ticket = the 40-byte record + two 8-byte index entries at
+     ~60% load. The textbook store spends most of its 177 B on
+     allocator headers, map nodes and bucket arrays.
+   - Plate lookup is ~5x faster: no std::string to build and one
+     probe run in a flat array instead of a chain of nodes.
+   - By id the two are close: std::hash<uint64_t> is the identity,
+     so both do about one cache miss into a table, then one into
+     the record.
+   - Timing each lookup alone (p50/p99) stops the CPU from overlapping
+     the cache misses of neighbouring lookups, so those numbers are
+     higher than the averages.
+   ========================================================== */